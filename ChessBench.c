@@ -0,0 +1,306 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L	// clock_gettime
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <time.h>	// clock
+
+#include "ChessCommonDefs.h"
+#include "ChessLogic.h"
+
+/* Move generator benchmark: runs perft on a fixed suite of positions, checks every count against
+   its reference and reports the elapsed time and nodes per second. Exits with 1 on any wrong count.
+   The reference counts follow this game's rules: no castling, no en passant and no double pawn step.
+   Run with "threads" it measures search thread scaling instead: the time the "best" difficulty takes to reach
+   a fixed depth with 1, 2, 4 and 8 threads, and checks that every thread count finds the same best moves.
+   It also reports the nodes searched and how often a cutoff came from the first move tried.
+   Run with "search" it measures the search features instead: every position is searched to the same depth
+   with none of them, then switching them on one at a time, and the nodes and time of each run are reported */
+
+typedef struct
+{
+	const char* name;
+	const char* placement;	// FEN piece placement, rows 8 to 1: upper case is white, lower case is black
+	PLAYER_COLOR nextPlayer;
+	int depth;
+	unsigned long long expectedNodes;
+} BENCH_POSITION;
+
+static const BENCH_POSITION m_benchSuite[] =
+{
+	{ "initial",    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR",                 PLAYER_COLOR_WHITE, 6, 9826886ULL },
+	{ "middlegame", "r3k2r/pPppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R",    PLAYER_COLOR_WHITE, 5, 175398497ULL },
+	{ "endgame",    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8",                            PLAYER_COLOR_WHITE, 6, 6788901ULL },
+	{ "promotions", "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N",                              PLAYER_COLOR_BLACK, 5, 3605103ULL },
+	{ "pins",       "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1",      PLAYER_COLOR_WHITE, 5, 9862396ULL },
+};
+
+#define BENCH_SUITE_SIZE	(sizeof(m_benchSuite) / sizeof(m_benchSuite[0]))
+
+/* time to depth positions, expectedNodes is unused */
+static const BENCH_POSITION m_scalingSuite[] =
+{
+	{ "initial",    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR",                 PLAYER_COLOR_WHITE, 6, 0 },
+	{ "middlegame", "r3k2r/pPppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R",    PLAYER_COLOR_WHITE, 5, 0 },
+	{ "endgame",    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8",                            PLAYER_COLOR_WHITE, 7, 0 },
+};
+
+#define SCALING_SUITE_SIZE	(sizeof(m_scalingSuite) / sizeof(m_scalingSuite[0]))
+
+/* the search features are compared deeper, where pruning pays */
+static const BENCH_POSITION m_searchSuite[] =
+{
+	{ "initial",    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR",                 PLAYER_COLOR_WHITE, 8, 0 },
+	{ "middlegame", "r3k2r/pPppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R",    PLAYER_COLOR_WHITE, 7, 0 },
+	{ "endgame",    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8",                            PLAYER_COLOR_WHITE, 10, 0 },
+	{ "pins",       "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1",      PLAYER_COLOR_WHITE, 7, 0 },
+};
+
+#define SEARCH_SUITE_SIZE	(sizeof(m_searchSuite) / sizeof(m_searchSuite[0]))
+
+static const int m_scalingThreads[] = { 1, 2, 4, 8 };
+
+#define SCALING_THREADS_SIZE	(sizeof(m_scalingThreads) / sizeof(m_scalingThreads[0]))
+
+/* the features switched on so far, in the order the "search" run adds them */
+typedef struct
+{
+	const char* name;
+	int features;
+} BENCH_FEATURES;
+
+static const BENCH_FEATURES m_featureSteps[] =
+{
+	{ "none",        0 },
+	{ "+pvs",        SEARCH_FEATURE_PVS },
+	{ "+aspiration", SEARCH_FEATURE_PVS | SEARCH_FEATURE_ASPIRATION },
+	{ "+null move",  SEARCH_FEATURE_PVS | SEARCH_FEATURE_ASPIRATION | SEARCH_FEATURE_NULL_MOVE },
+	{ "+lmr",        SEARCH_FEATURE_PVS | SEARCH_FEATURE_ASPIRATION | SEARCH_FEATURE_NULL_MOVE | SEARCH_FEATURE_LMR },
+	{ "+futility",   SEARCH_FEATURES_ALL & ~(SEARCH_FEATURE_RAZORING | SEARCH_FEATURE_CHECK_EXTENSION | SEARCH_FEATURE_SINGLE_REPLY) },
+	{ "+razoring",   SEARCH_FEATURES_ALL & ~(SEARCH_FEATURE_CHECK_EXTENSION | SEARCH_FEATURE_SINGLE_REPLY) },
+	{ "+check ext",  SEARCH_FEATURES_ALL & ~SEARCH_FEATURE_SINGLE_REPLY },
+	{ "+single rep", SEARCH_FEATURES_ALL },
+};
+
+#define FEATURE_STEPS_SIZE	(sizeof(m_featureSteps) / sizeof(m_featureSteps[0]))
+#define SCALING_TIME_LIMIT		(60 * 60 * 1000)	// milliseconds, only the depth ends a search
+#define TT_BENCH_SIZE_MB		16
+#define BENCH_ARG_THREADS		"threads"
+#define BENCH_ARG_SEARCH		"search"
+
+static CHESS_PIECE_TYPE ChessBenchConvertFenPiece(char piece)
+{
+	switch (piece)
+	{
+	case 'P': return WHITE_PAWN;
+	case 'B': return WHITE_BISHOP;
+	case 'N': return WHITE_KNIGHT;
+	case 'R': return WHITE_ROOK;
+	case 'Q': return WHITE_QUEEN;
+	case 'K': return WHITE_KING;
+	case 'p': return BLACK_PAWN;
+	case 'b': return BLACK_BISHOP;
+	case 'n': return BLACK_KNIGHT;
+	case 'r': return BLACK_ROOK;
+	case 'q': return BLACK_QUEEN;
+	case 'k': return BLACK_KING;
+	default: return PIECE_TYPE_INVALID;
+	}
+}
+
+static void ChessBenchLoadPlacement(const char* placement, BOARD board)
+{
+	int row = BOARD_SIZE - 1;
+	int column = 0;
+	memset(board, BLANK_POSITION, sizeof(BOARD));
+	for (; *placement != '\0'; placement++)
+	{
+		if ('/' == *placement)
+		{
+			row--;
+			column = 0;
+		}
+		else if ('1' <= *placement && *placement <= '8')
+		{
+			column += *placement - '0';
+		}
+		else
+		{
+			board[column++][row] = ChessBenchConvertFenPiece(*placement);
+		}
+	}
+}
+
+// wall clock seconds, clock() adds up the time of all the threads
+static double ChessBenchWallSeconds(void)
+{
+#ifdef _WIN32
+	return (double)clock() / CLOCKS_PER_SEC;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+#endif
+}
+
+static int ChessBenchSameMoves(GAME_MOVE_PTR pFirst, GAME_MOVE_PTR pSecond)
+{
+	for (; pFirst != NULL && pSecond != NULL; pFirst = pFirst->pNextMove, pSecond = pSecond->pNextMove)
+	{
+		if (pFirst->origin.column != pSecond->origin.column || pFirst->origin.row != pSecond->origin.row
+			|| pFirst->destination.column != pSecond->destination.column || pFirst->destination.row != pSecond->destination.row
+			|| pFirst->newType != pSecond->newType)
+		{
+			return 0;
+		}
+	}
+	return pFirst == NULL && pSecond == NULL;
+}
+
+static int ChessBenchThreadScaling(void)
+{
+	BOARD board;
+	GAME_MOVE_PTR pSingleThreadMoves = NULL;
+	GAME_MOVE_PTR pMoves;
+	SEARCH_STATS stats;
+	unsigned int i, j;
+	double seconds;
+	double singleThreadSeconds = 0;
+	double start;
+	int failures = 0;
+
+	ChessLogicSetSearchBudget(SCALING_TIME_LIMIT, 0);
+	printf("%-12s %5s %7s %10s %8s %12s %10s\n", "position", "depth", "threads", "seconds", "speedup", "nodes", "first cut");
+	for (i = 0; i < SCALING_SUITE_SIZE; i++)
+	{
+		ChessBenchLoadPlacement(m_scalingSuite[i].placement, board);
+		ChessLogicSetSearchDepth(m_scalingSuite[i].depth);
+		for (j = 0; j < SCALING_THREADS_SIZE; j++)
+		{
+			ChessLogicLoadCompleteBoard(board);
+			ChessLogicSetNextPlayer(m_scalingSuite[i].nextPlayer);
+			ChessLogicSetThreads(m_scalingThreads[j]);
+			ChessLogicSetHashSize(TT_BENCH_SIZE_MB); // every run starts from an empty table
+
+			start = ChessBenchWallSeconds();
+			ChessLogicGetBestMoves(GAME_DIFFICULTY_BEST, &pMoves);
+			seconds = ChessBenchWallSeconds() - start;
+			ChessLogicGetSearchStats(&stats);
+			if (j == 0)
+			{
+				pSingleThreadMoves = pMoves;
+				singleThreadSeconds = seconds;
+			}
+
+			printf("%-12s %5d %7d %10.3f %8.2f %12llu %9.1f%%", m_scalingSuite[i].name, m_scalingSuite[i].depth, m_scalingThreads[j], seconds, seconds > 0 ? singleThreadSeconds / seconds : 0,
+				stats.nodes, stats.cutoffs > 0 ? 100.0 * stats.firstMoveCutoffs / stats.cutoffs : 0);
+			if (!ChessBenchSameMoves(pSingleThreadMoves, pMoves))
+			{
+				printf("  DIFFERENT BEST MOVES");
+				failures++;
+			}
+			printf("\n");
+			if (j != 0)
+			{
+				ChessLogicFreeMovesList(pMoves);
+			}
+		}
+		ChessLogicFreeMovesList(pSingleThreadMoves);
+	}
+	ChessLogicSetThreads(1);
+	ChessLogicSetSearchDepth(0);
+	return failures;
+}
+
+static void ChessBenchSearchFeatures(void)
+{
+	BOARD board;
+	GAME_MOVE_PTR pMoves;
+	SEARCH_STATS stats;
+	unsigned long long noneNodes = 0;
+	unsigned int i, j;
+	double seconds;
+	double start;
+
+	ChessLogicSetSearchBudget(SCALING_TIME_LIMIT, 0);
+	ChessLogicSetThreads(1);
+	printf("%-12s %5s %-12s %12s %10s %8s\n", "position", "depth", "features", "nodes", "seconds", "nodes %");
+	for (i = 0; i < SEARCH_SUITE_SIZE; i++)
+	{
+		ChessBenchLoadPlacement(m_searchSuite[i].placement, board);
+		ChessLogicSetSearchDepth(m_searchSuite[i].depth);
+		for (j = 0; j < FEATURE_STEPS_SIZE; j++)
+		{
+			ChessLogicLoadCompleteBoard(board);
+			ChessLogicSetNextPlayer(m_searchSuite[i].nextPlayer);
+			ChessLogicSetHashSize(TT_BENCH_SIZE_MB);
+			ChessLogicSetSearchFeature(SEARCH_FEATURES_ALL, 0);
+			ChessLogicSetSearchFeature(m_featureSteps[j].features, 1);
+
+			start = ChessBenchWallSeconds();
+			ChessLogicGetBestMoves(GAME_DIFFICULTY_BEST, &pMoves);
+			seconds = ChessBenchWallSeconds() - start;
+			ChessLogicGetSearchStats(&stats);
+			ChessLogicFreeMovesList(pMoves);
+			if (j == 0)
+			{
+				noneNodes = stats.nodes;
+			}
+			printf("%-12s %5d %-12s %12llu %10.3f %7.1f%%\n", m_searchSuite[i].name, m_searchSuite[i].depth, m_featureSteps[j].name,
+				stats.nodes, seconds, noneNodes > 0 ? 100.0 * stats.nodes / noneNodes : 0);
+		}
+	}
+	ChessLogicSetSearchFeature(SEARCH_FEATURES_ALL, 1);
+	ChessLogicSetSearchDepth(0);
+}
+
+int main(int argc, const char* argv[])
+{
+	BOARD board;
+	unsigned int i;
+	unsigned long long nodes;
+	unsigned long long totalNodes = 0;
+	double seconds;
+	double totalSeconds = 0;
+	clock_t start;
+	int failures = 0;
+
+	if (argc > 1 && 0 == strcmp(argv[1], BENCH_ARG_THREADS))
+	{
+		failures = ChessBenchThreadScaling();
+		ChessLogicTerminate();
+		return (failures > 0) ? 1 : 0;
+	}
+	if (argc > 1 && 0 == strcmp(argv[1], BENCH_ARG_SEARCH))
+	{
+		ChessBenchSearchFeatures();
+		ChessLogicTerminate();
+		return 0;
+	}
+
+	printf("%-12s %5s %12s %10s %14s\n", "position", "depth", "nodes", "seconds", "nodes/second");
+	for (i = 0; i < BENCH_SUITE_SIZE; i++)
+	{
+		ChessBenchLoadPlacement(m_benchSuite[i].placement, board);
+		ChessLogicLoadCompleteBoard(board);
+		ChessLogicSetNextPlayer(m_benchSuite[i].nextPlayer);
+
+		start = clock();
+		nodes = ChessLogicPerft(m_benchSuite[i].depth);
+		seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+		printf("%-12s %5d %12llu %10.3f %14.0f", m_benchSuite[i].name, m_benchSuite[i].depth, nodes, seconds, seconds > 0 ? nodes / seconds : 0);
+		if (nodes != m_benchSuite[i].expectedNodes)
+		{
+			printf("  WRONG COUNT, expected %llu", m_benchSuite[i].expectedNodes);
+			failures++;
+		}
+		printf("\n");
+		totalNodes += nodes;
+		totalSeconds += seconds;
+	}
+	printf("%-12s %5s %12llu %10.3f %14.0f\n", "total", "", totalNodes, totalSeconds, totalSeconds > 0 ? totalNodes / totalSeconds : 0);
+
+	ChessLogicTerminate();
+	return (failures > 0) ? 1 : 0;
+}
@@ -116,6 +116,7 @@ static void ChessCLIInitCmdHandlers();
 static void ChessCLIDisplayCmdStatus(CMD_OPCODE, COMMAND_STATUS);
 static COMMAND ChessCLIGetUserCmd(void);
 static void ChessCLIDisplayScore(int score);
+static void ChessCLIDisplayPerftMove(GAME_MOVE, unsigned long long);
 
 // UT needs to be "friend", therefore not static
 COMMAND ChessCLIParseUserCmd(char* pCmdBuffer);
@@ -205,6 +206,8 @@ static void ChessCLIInitCmdStatusMap()
 	m_cmdStatusMap[GAME_CMD_GET_BEST_MOVES][CMD_INVALID] = CLI_STR_ILLEGAL_COMMAND;
 	m_cmdStatusMap[GAME_CMD_GET_SCORE][CMD_INVALID] = CLI_STR_ILLEGAL_COMMAND;
 	m_cmdStatusMap[GAME_CMD_SAVE][CMD_INVALID] = CLI_STR_ILLEGAL_COMMAND;
+	m_cmdStatusMap[GAME_CMD_PERFT][CMD_INVALID] = CLI_STR_ILLEGAL_COMMAND;
+	m_cmdStatusMap[GAME_CMD_PERFT][CMD_INVALID_ARGUMENT] = CLI_STR_PERFT_USAGE;
 }
 
 static CMD_OPCODE ChessCLIMapCmdStringToOpcode(const char* cmdString)
@@ -274,6 +277,10 @@ static CMD_OPCODE ChessCLIMapCmdStringToOpcode(const char* cmdString)
 	{
 		return GAME_CMD_SAVE;
 	}
+	else if (0 == strncmp(GAME_CMD_PERFT_CLI_STRING, cmdString, MAX_CLI_COMMAND_LENGTH))
+	{
+		return GAME_CMD_PERFT;
+	}
 
 	else if (0 == strncmp(GENERAL_CMD_QUIT_CLI_STRING, cmdString, MAX_CLI_COMMAND_LENGTH))
 	{
@@ -511,6 +518,24 @@ static void ChessCLIDisplayScore(int score)
 	CLI_PRINT("%d\n", score);
 }
 
+static void ChessCLIDisplayPerftMove(GAME_MOVE move, unsigned long long nodes)
+{
+	char origCol;
+	char destCol;
+	int origRow;
+	int destRow;
+	const char* newPieceTypeStr;
+	CONVERT_MOVE_TO_STRING_REPRESENTATION(move, origCol, origRow, destCol, destRow, newPieceTypeStr);
+	if (0 == strcmp(CLI_STRING_PIECE_TYPE_BLANK, newPieceTypeStr))
+	{
+		CLI_PRINT(CLI_STR_DISPLAY_PERFT_MOVE_NO_PROMOTION, origCol, origRow, destCol, destRow, nodes);
+	}
+	else
+	{
+		CLI_PRINT(CLI_STR_DISPLAY_PERFT_MOVE_WITH_PROMOTION, origCol, origRow, destCol, destRow, newPieceTypeStr, nodes);
+	}
+}
+
 static void ChessCLITerminate(void)
 {
 	FUNCTION_DEBUG_TRACE;
@@ -844,6 +869,7 @@ static COMMAND_STATUS CommandHandlerGetScore(COMMAND cmd)
 	VALIDATE_POSITION_STRING(destinationStr);
 	CONVERT_BOARD_POSITION_INTERFACE_REPRESENTATION_TO_INTERNAL_DATA(move.origin, originStr);
 	CONVERT_BOARD_POSITION_INTERFACE_REPRESENTATION_TO_INTERNAL_DATA(move.destination, destinationStr);
+	move.newType = BLANK_POSITION;
 
 	// assume that d is either a number between 1-4 or the value best
 	difficultyStr = cmd.argv[1];
@@ -1046,6 +1072,39 @@ static COMMAND_STATUS CommandHandlerGetBestMoves(COMMAND cmd)
 	return CMD_SUCCESS;
 }
 
+static COMMAND_STATUS CommandHandlerPerft(COMMAND cmd)
+{
+	int depth;
+	unsigned long long nodes;
+	FUNCTION_DEBUG_TRACE;
+	assert(GAME_CMD_PERFT == cmd.opcode);
+	if (cmd.argc < 2 || cmd.argc > 3)
+	{
+		return CMD_INVALID_ARGUMENT;
+	}
+	depth = atoi(cmd.argv[1]);
+	if (depth < 1)
+	{
+		return CMD_INVALID_ARGUMENT;
+	}
+
+	// divide: the count below every legal move, then the total
+	if (3 == cmd.argc)
+	{
+		if (0 != strncmp(cmd.argv[2], GAME_CMD_ARG_PERFT_DIVIDE_CLI_STRING, MAX_CLI_COMMAND_LENGTH))
+		{
+			return CMD_INVALID_ARGUMENT;
+		}
+		nodes = ChessLogicPerftDivide(depth, ChessCLIDisplayPerftMove);
+	}
+	else
+	{
+		nodes = ChessLogicPerft(depth);
+	}
+	CLI_PRINT(CLI_STR_DISPLAY_PERFT_NODES, nodes);
+	return CMD_SUCCESS;
+}
+
 
 static void ChessCLIInitCmdHandlers()
 {
@@ -1172,6 +1231,14 @@ static void ChessCLIInitCmdHandlers()
 	m_cmdHandlers[FLOW_STATE_GAME][GAME_MODE_TWO_PLAYERS][GAME_CMD_SAVE] = CommandHandlerSaveGame;
 	m_cmdHandlers[FLOW_STATE_GAME][GAME_MODE_COMPUTER_AI][GAME_CMD_SAVE] = CommandHandlerSaveGame;
 
+	/* Perft */
+	/* Valid only in game state (the board was validated when the game started) */
+	/* Valid for both game modes */
+	m_cmdHandlers[FLOW_STATE_SETTINGS][GAME_MODE_TWO_PLAYERS][GAME_CMD_PERFT] = CommandHandlerInvalid;
+	m_cmdHandlers[FLOW_STATE_SETTINGS][GAME_MODE_COMPUTER_AI][GAME_CMD_PERFT] = CommandHandlerInvalid;
+	m_cmdHandlers[FLOW_STATE_GAME][GAME_MODE_TWO_PLAYERS][GAME_CMD_PERFT] = CommandHandlerPerft;
+	m_cmdHandlers[FLOW_STATE_GAME][GAME_MODE_COMPUTER_AI][GAME_CMD_PERFT] = CommandHandlerPerft;
+
 	/* Quit */
 	/* Valid in both settings states */
 	/* Valid for both game modes */
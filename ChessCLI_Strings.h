@@ -64,11 +64,14 @@
 #define GAME_CMD_GET_SCORE_CLI_STRING            	"get_score"
 #define GAME_CMD_SAVE_CLI_STRING                  	"save"
 #define GAME_CMD_QUIT_GAME_CLI_STRING             	"quit"
+#define GAME_CMD_PERFT_CLI_STRING                 	"perft"
+#define GAME_CMD_ARG_PERFT_DIVIDE_CLI_STRING      	"divide"
 
 #define CLI_STR_GET_MOVES_USAGE              "usage: \"get_moves <x,y>\"\n"
 #define CLI_STR_GET_BEST_MOVES_USAGE         "usage: \"get_best_moves d\"\n"
 #define CLI_STR_GET_SCORE_USAGE              "usage: \"get_score d move <x,y> to <i,j> x\"\n"
 #define CLI_STR_SAVE_USAGE                   "usage: \"save filepath\"\n"
+#define CLI_STR_PERFT_USAGE                  "usage: \"perft d [divide]\"\n"
 
 //#define CLI_STR_WRONG_ROOK_POSITION                "Wrong position for a rook\n" 
 //#define CLI_STR_ILLEGAL_CALTLING_MOVE              "Illegal castling move\n"  
@@ -77,6 +80,9 @@
 #define CLI_STR_DISPLAY_MOVE_NO_PROMOTION		"<%c,%c> to <%c,%c>\n"
 #define CLI_STR_DISPLAY_MOVE_WITH_PROMOTION		"<%c,%c> to <%c,%c> %s\n"
 #define CLI_STR_DISPLAY_COMPUTER_MOVE			"Computer: move <%c,%c> to <%c,%c> %s\n"
+#define CLI_STR_DISPLAY_PERFT_MOVE_NO_PROMOTION	"<%c,%c> to <%c,%c>: %llu\n"
+#define CLI_STR_DISPLAY_PERFT_MOVE_WITH_PROMOTION	"<%c,%c> to <%c,%c> %s: %llu\n"
+#define CLI_STR_DISPLAY_PERFT_NODES				"Nodes: %llu\n"
 #define CLI_STR_GAME_TIE						"The game ends in a tie\n"
 #define CLI_STR_CHECK							"Check!\n"
 #define CLI_STR_CHECK_MATE						"Mate! %s player wins the game\n"
@@ -31,10 +31,11 @@ typedef enum
 	GAME_CMD_GET_BEST_MOVES,
 	GAME_CMD_GET_SCORE,
 	GAME_CMD_SAVE,
+	GAME_CMD_PERFT,
 	CMD_OPCODE_INVALID,
 	NUM_OF_COMMANDS,
 	GAME_CMD_MIN = GAME_CMD_MOVE,
-	GAME_CMD_MAX = GAME_CMD_SAVE,
+	GAME_CMD_MAX = GAME_CMD_PERFT,
 
 } CMD_OPCODE;
 
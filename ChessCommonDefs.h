@@ -114,4 +114,26 @@ typedef struct move {
 	struct move* pNextMove;
 } GAME_MOVE, *GAME_MOVE_PTR;
 
+/* Search techniques of the computer that can be switched off, to compare the engine with and without them.
+   They may be or'ed together. All are on by default */
+typedef enum {
+	SEARCH_FEATURE_PVS = 1 << 0,			// principal variation search: moves after the first get a null window scout
+	SEARCH_FEATURE_ASPIRATION = 1 << 1,		// iterative deepening searches the root in a window around the last score
+	SEARCH_FEATURE_NULL_MOVE = 1 << 2,		// a node still past the window after passing the turn is cut
+	SEARCH_FEATURE_LMR = 1 << 3,			// late move reductions: quiet moves far down the order are searched shallower first
+	SEARCH_FEATURE_FUTILITY = 1 << 4,		// near the horizon, quiet moves that cant bring the static score to the window are skipped
+	SEARCH_FEATURE_RAZORING = 1 << 5,		// near the horizon, a node far behind the window only plays out its captures
+	SEARCH_FEATURE_CHECK_EXTENSION = 1 << 6,	// a side under check is searched a ply deeper
+	SEARCH_FEATURE_SINGLE_REPLY = 1 << 7,		// the only move of a node is searched a ply deeper
+	SEARCH_FEATURES_ALL = SEARCH_FEATURE_PVS | SEARCH_FEATURE_ASPIRATION | SEARCH_FEATURE_NULL_MOVE | SEARCH_FEATURE_LMR
+		| SEARCH_FEATURE_FUTILITY | SEARCH_FEATURE_RAZORING | SEARCH_FEATURE_CHECK_EXTENSION | SEARCH_FEATURE_SINGLE_REPLY
+} SEARCH_FEATURE;
+
+/* Counts of the last search of the computer */
+typedef struct {
+	unsigned long long nodes;
+	unsigned long long cutoffs;				// nodes cut before all their moves were searched
+	unsigned long long firstMoveCutoffs;	// of those, the nodes cut by the first move: the move ordering hit
+} SEARCH_STATS;
+
 #endif
\ No newline at end of file
@@ -18,8 +18,7 @@
 #include "GenericMinimaxAlgorithm.h"
 #include "CommonUtils.h"
 #include "ChessCommonUtils.h"
-
-#define MAX_MOVES_PER_PIECE 27
+#include "ChessLogicProtected.h"
 
 /* GLOBAL DATA */
 
@@ -32,6 +31,7 @@ static PLAYER_COLOR userColor = PLAYER_COLOR_DEFAULT;
 
 /* dynamic game data */
 static BOARD board;
+static CHESS_POSITION position; // bitboard view of board, kept in sync by every method that changes it
 static PLAYER_COLOR currPlayer = PLAYER_COLOR_DEFAULT;
 static GAME_MOVE_PTR userMoves;
 static GAME_MOVE_PTR otherMoves;
@@ -44,6 +44,7 @@ PLAYER_COLOR userColor = PLAYER_COLOR_DEFAULT;
 
 /* dynamic game data */
 BOARD board;
+CHESS_POSITION position;
 PLAYER_COLOR currPlayer = PLAYER_COLOR_DEFAULT;
 GAME_MOVE_PTR userMoves;
 GAME_MOVE_PTR otherMoves;
@@ -51,27 +52,17 @@ GAME_MOVE_PTR otherMoves;
 
 /* PRIVATE METHODS DECLARATIONS */
 
-int ChessLogicValidPlace(int, int); // checks that the position is valid, returns 1 if this is valid place
 void ChessLogicCountPieces(BOARD, int *); // updates an array of pieces
 int ChessLogicSetMorePieces(); // returns 1 if the board set caused problem
+void ChessLogicSyncPosition(); // rebuilds the bitboard position after board was changed
 MOVE_STATUS ChessLogicCorrectColor(GAME_MOVE); // checks that the piece has the correct color
 MOVE_STATUS ChessLogicLegalMove(GAME_MOVE); // checks if the move is legal, return 1 if its a legal move 
 PLAYER_COLOR ChessLogicCheckColor(BOARD, int, int); // return the color of the piece located in that place
-GAME_MOVE_PTR ChessInternalGetAllMoves(BOARD, PLAYER_COLOR,int);
 void ChessLogicFreeMovesList(GAME_MOVE_PTR); // free a specefic list
-MOVE_STATUS ChessLogicGetMovesPiece(BOARD, BOARD_LOCATION , GAME_MOVE_PTR*, PLAYER_COLOR,int); // return moves for piece, intarnal 
-GAME_MOVE_PTR ChessLogicGetMovesPawn(BOARD, int, int, PLAYER_COLOR); // get moves for one pawn
-GAME_MOVE_PTR ChessLogicGetMovesRook(BOARD, int, int, PLAYER_COLOR); // get moves for one rook
-GAME_MOVE_PTR ChessLogicGetMovesKnight(BOARD, int, int, PLAYER_COLOR); // get moves for one knight
-GAME_MOVE_PTR ChessLogicGetMovesBishop(BOARD, int, int, PLAYER_COLOR); // get moves for one bishop
-GAME_MOVE_PTR ChessLogicGetMovesQueen(BOARD, int, int, PLAYER_COLOR); // get moves for one queen
-GAME_MOVE_PTR ChessLogicGetMovesKing(BOARD, int, int, PLAYER_COLOR); // get moves for one king
-void ChessLogicCreateBoardAfterMove(BOARD, GAME_MOVE, BOARD); // creates a temp board after a move 
+GAME_MOVE_PTR ChessLogicMoveBufferToList(const MOVE_BUFFER*); // allocates a moves list out of a buffer
+GAME_MOVE_PTR ChessLogicGetAllMovesList(CHESS_POSITION*, PLAYER_COLOR); // allocates a list of all the legal moves of color
 GAME_MOVE_PTR ChessLogicCreateMove(int, int, int, int, GAME_MOVE_PTR, CHESS_PIECE_TYPE); // allocates and creates a move node
-BOARD_LOCATION ChessLogicFindKing(BOARD, PLAYER_COLOR); // find the king
-int ChessLogicIsCheck(BOARD, PLAYER_COLOR); // returns 1 if its a CHECK
-int ChessLogicIsMate(BOARD, PLAYER_COLOR); //returns 1 if player color is under checkmate 		
-int ChessLogicBoardScore(BOARD, PLAYER_COLOR);  // returns the score of the board
+int ChessLogicScoreRootMoves(GAME_DIFFICULTY, PLAYER_COLOR, const MOVE_BUFFER*, int*, int); // scores the root moves for a difficulty, returns the depth
 
 
 /* PUBLIC API METHODS IMPLEMENTATIONS */
@@ -107,11 +98,14 @@ void ChessLogicInitializeBoard() {
 	for (i = 0; i < BOARD_SIZE; i++)
 		for (j = 2; j < BOARD_SIZE - 2; j++)
 			board[i][j] = BLANK_POSITION;
+	ChessLogicSyncPosition();
 }
 
 void ChessLogicTerminate() {
 	ChessLogicFreeMovesList(userMoves);
 	ChessLogicFreeMovesList(otherMoves);
+	ChessLogicSearchStopThreads();
+	ChessLogicTTFree();
 }
 /* Settings Functionality */
 void ChessLogicSetGameMode(GAME_MODE mode) {
@@ -126,6 +120,39 @@ void ChessLogicSetUserColor(PLAYER_COLOR color) {
 	VALIDATE_PLAYER_COLOR(color);
 	userColor = color;
 }
+int ChessLogicSetHashSize(unsigned int megabytes) {
+	return ChessLogicTTResize(megabytes);
+}
+
+void ChessLogicSetSearchBudget(unsigned int milliseconds, unsigned long long nodes) {
+	ChessLogicSearchSetBudget(milliseconds, nodes);
+}
+
+int ChessLogicSetThreads(int threads) {
+	return ChessLogicSearchSetThreads(threads);
+}
+
+int ChessLogicSetSearchDepth(int depth) {
+	return ChessLogicSearchSetDepth(depth);
+}
+
+void ChessLogicSetSearchFeature(int features, int enabled) {
+	ChessLogicSearchSetFeature(features, enabled);
+}
+
+unsigned int ChessLogicGetSearchId() {
+	return ChessLogicSearchId();
+}
+
+int ChessLogicStopSearch(unsigned int searchId) {
+	return ChessLogicSearchCancel(searchId);
+}
+
+void ChessLogicGetSearchStats(SEARCH_STATS* pStats) {
+	pStats->nodes = ChessLogicSearchNodes();
+	ChessLogicSearchCutoffs(&pStats->cutoffs, &pStats->firstMoveCutoffs);
+}
+
 void ChessLogicSetNextPlayer(PLAYER_COLOR color) {
 	VALIDATE_PLAYER_COLOR(color);
 	currPlayer = color;
@@ -178,6 +205,7 @@ MOVE_STATUS ChessLogicSetBoardPiece(BOARD_LOCATION place, PLAYER_COLOR color, CH
 		DEBUG_PRINT("returning ILLEGAL_BOARD_INITIALIZATION");
 		return ILLEGAL_BOARD_INITIALIZATION;
 	}
+	ChessLogicSyncPosition();
 	DEBUG_PRINT("returning MOVE_SUCCESSFUL");
 	return MOVE_SUCCESSFUL; // if evertythink was ok, success
 }
@@ -187,6 +215,7 @@ MOVE_STATUS ChessLogicRemoveBoardPiece(BOARD_LOCATION place) {
 	int y = place.row;
 	if (ChessLogicValidPlace(x, y)) {
 		board[x][y] = BLANK_POSITION;
+		ChessLogicSyncPosition();
 		DEBUG_PRINT("returning MOVE_SUCCESSFUL");
 		return MOVE_SUCCESSFUL;
 	}
@@ -201,6 +230,7 @@ void ChessLogicClearBoard() {
 	for (i = 0; i < BOARD_SIZE; i++)
 		for (j = 0; j < BOARD_SIZE; j++)
 			board[i][j] = BLANK_POSITION;
+	ChessLogicSyncPosition();
 }
 
 void ChessLogicResetDefaultSettings() { ///restars all the settings, insert their default value
@@ -215,41 +245,34 @@ void ChessLogicResetDefaultSettings() { ///restars all the settings, insert thei
 
 MOVE_STATUS ChessLogicStartGame() {
 	PLAYER_COLOR oppositeColor = PLAYER_COLOR_WHITE;	
-	GAME_MOVE_PTR tempMoves = NULL;	
-	BOARD_LOCATION whiteKingPlace = ChessLogicFindKing(board, PLAYER_COLOR_WHITE);
-	BOARD_LOCATION blackKingPlace = ChessLogicFindKing(board, PLAYER_COLOR_BLACK);
-	if ((whiteKingPlace.column == -1) || (blackKingPlace.column == -1)) {
+	if ((position.pieces[WHITE_KING] == BITBOARD_EMPTY) || (position.pieces[BLACK_KING] == BITBOARD_EMPTY)) {
 		DEBUG_PRINT("returning ILLEGAL_BOARD_INITIALIZATION");
 		return ILLEGAL_BOARD_INITIALIZATION;
 	}
 	if (userColor == PLAYER_COLOR_WHITE)
 		oppositeColor = PLAYER_COLOR_BLACK;
-	userMoves = ChessInternalGetAllMoves(board, userColor,1);
-	otherMoves = ChessInternalGetAllMoves(board, oppositeColor,1);
+	ChessLogicTTClear(); // the positions of the previous game are of no use to this one
+	ChessLogicFreeMovesList(userMoves);
+	ChessLogicFreeMovesList(otherMoves);
+	userMoves = ChessLogicGetAllMovesList(&position, userColor);
+	otherMoves = ChessLogicGetAllMovesList(&position, oppositeColor);
 
 	// check if the board started with check or tie, altough it was written in the forum that it wont be tested. 	
-	if (ChessLogicIsCheck(board, currPlayer)) {
+	if (ChessLogicIsCheck(&position, currPlayer)) {
 		DEBUG_PRINT("returning CHECK");
 		return CHECK;
 	}
-	if (currPlayer == PLAYER_COLOR_WHITE) {
-		tempMoves = ChessInternalGetAllMoves(board, PLAYER_COLOR_WHITE, 1);
-	}
-	else {
-		tempMoves = ChessInternalGetAllMoves(board, PLAYER_COLOR_BLACK, 1);
-	}	
-	if (tempMoves == NULL) {	// the first player is under tie
+	if (!ChessLogicHasLegalMove(&position, currPlayer)) {	// the first player is under tie
 		DEBUG_PRINT("returning GAME_TIE");
 		return GAME_TIE;
 	}
-	ChessLogicFreeMovesList(tempMoves);	
 	VERBOSE_PRINT("returning MOVE_SUCCESSFUL");
 	return MOVE_SUCCESSFUL;
 }
 
 MOVE_STATUS ChessLogicPerformUserMove(GAME_MOVE move) {
 	PLAYER_COLOR oppositeColor = PLAYER_COLOR_BLACK;
-	int moveFound = 0, checkFlag = 0;	
+	int moveFound = 0, checkFlag = 0, canMove;	
 	GAME_MOVE_PTR copyMoves;
 	assert(0 <= move.newType && move.newType <= NUM_OF_PIECE_TYPES);
 	DEBUG_PRINT("<%d,%d> --> <%d,%d> newType=%d", move.origin.column, move.origin.row, move.destination.column, move.destination.row, move.newType);
@@ -304,14 +327,16 @@ MOVE_STATUS ChessLogicPerformUserMove(GAME_MOVE move) {
 		board[move.destination.column][move.destination.row] = board[move.origin.column][move.origin.row];
 		board[move.origin.column][move.origin.row] = BLANK_POSITION;
 	}	
+	ChessLogicSyncPosition();
 
 	if (currPlayer == PLAYER_COLOR_BLACK)
 		oppositeColor = PLAYER_COLOR_WHITE;
 
-	if (ChessLogicIsCheck(board, oppositeColor))
+	if (ChessLogicIsCheck(&position, oppositeColor))
 		checkFlag = 1;
 
-	if (ChessLogicIsMate(board, oppositeColor) && checkFlag){ // if there is no check, its tie 
+	canMove = ChessLogicHasLegalMove(&position, oppositeColor);
+	if (!canMove && checkFlag){ // if there is no check, its tie 
 		DEBUG_PRINT("returning CHECK_MATE");		
 		return CHECK_MATE;
 	}
@@ -322,18 +347,18 @@ MOVE_STATUS ChessLogicPerformUserMove(GAME_MOVE move) {
 
 	// create new lists
 	if (currPlayer == userColor) {
-		userMoves = ChessInternalGetAllMoves(board, currPlayer,1);
-		otherMoves = ChessInternalGetAllMoves(board, oppositeColor,1);
-		if ((otherMoves == NULL) && (checkFlag == 0)) {
+		userMoves = ChessLogicGetAllMovesList(&position, currPlayer);
+		otherMoves = ChessLogicGetAllMovesList(&position, oppositeColor);
+		if (!canMove && (checkFlag == 0)) {
 			//	ChessLogicFreeMovesList(userMoves);
 			DEBUG_PRINT("returning GAME_TIE");		
 			return GAME_TIE;
 		}			
 	}
 	else {
-		otherMoves = ChessInternalGetAllMoves(board, currPlayer,1);
-		userMoves = ChessInternalGetAllMoves(board, oppositeColor,1);
-		if ((userMoves == NULL) && (checkFlag == 0)) {
+		otherMoves = ChessLogicGetAllMovesList(&position, currPlayer);
+		userMoves = ChessLogicGetAllMovesList(&position, oppositeColor);
+		if (!canMove && (checkFlag == 0)) {
 			//ChessLogicFreeMovesList(otherMoves);
 			DEBUG_PRINT("returning GAME_TIE");		
 			return GAME_TIE;
@@ -349,6 +374,8 @@ MOVE_STATUS ChessLogicPerformUserMove(GAME_MOVE move) {
 
 MOVE_STATUS ChessLogicGetMoves(BOARD_LOCATION place, GAME_MOVE_PTR* outputParamHeadOfListOfMoves) {
 	PLAYER_COLOR boardColor = ChessLogicCheckColor(board, place.column, place.row);
+	MOVE_BUFFER moves;
+	MOVE_STATUS status;
 	// checks if start and end of moves are valid positiona on the board
 	if (!ChessLogicValidPlace(place.column, place.row)) {
 		DEBUG_PRINT("returning INVALID_BOARD_POSITION");
@@ -359,132 +386,15 @@ MOVE_STATUS ChessLogicGetMoves(BOARD_LOCATION place, GAME_MOVE_PTR* outputParamH
 		return INVALID_PIECE; // message 2
 	}
 	
-	return ChessLogicGetMovesPiece(board, place, outputParamHeadOfListOfMoves, ChessLogicCheckColor(board, place.column, place.row),1);
-}
-
-MOVE_STATUS ChessLogicGetMovesPiece(BOARD board, BOARD_LOCATION place, GAME_MOVE_PTR* outputParamHeadOfListOfMoves, PLAYER_COLOR color,int filter) {	
-	int x = place.column;
-	int y = place.row;
-	GAME_MOVE_PTR first = NULL;
-	BOARD tempBoard;
-	GAME_MOVE_PTR dummyMoves = NULL;
-	GAME_MOVE_PTR currMove = NULL;
-	GAME_MOVE_PTR prevMove = NULL;
-
-	CHESS_PIECE_TYPE type = board[x][y];
-	PLAYER_COLOR boardColor = ChessLogicCheckColor(board, x, y);
-
-	// checks if start and end of moves are valid positiona on the board
-	if (!ChessLogicValidPlace(x, y)) {
-		DEBUG_PRINT("returning INVALID_BOARD_POSITION");
-		return INVALID_BOARD_POSITION; // message 1		
-	}
-	// checks if the position contains the correct color	
-	if (boardColor != color) {
-		DEBUG_PRINT("returning INVALID_PIECE");
-		return INVALID_PIECE; // message 2
-	}
-	
-	if (color == PLAYER_COLOR_BLANK) {
-		DEBUG_PRINT("returning INVALID_PIECE");
-		return INVALID_PIECE; // message 2
-	}
-
-	// get moves of the right type_piece
-	if (type == WHITE_PAWN || type == BLACK_PAWN)
-		*outputParamHeadOfListOfMoves = ChessLogicGetMovesPawn(board, x, y, color);
-	else if (type == WHITE_ROOK || type == BLACK_ROOK)
-		*outputParamHeadOfListOfMoves = ChessLogicGetMovesRook(board, x, y, color);
-	else if (type == WHITE_KNIGHT || type == BLACK_KNIGHT)
-		*outputParamHeadOfListOfMoves = ChessLogicGetMovesKnight(board, x, y, color);
-	else if (type == WHITE_BISHOP || type == BLACK_BISHOP)
-		*outputParamHeadOfListOfMoves = ChessLogicGetMovesBishop(board, x, y, color);
-	else if (type == WHITE_QUEEN || type == BLACK_QUEEN)
-		*outputParamHeadOfListOfMoves = ChessLogicGetMovesQueen(board, x, y, color);
-	else if (type == WHITE_KING || type == BLACK_KING)
-		*outputParamHeadOfListOfMoves = ChessLogicGetMovesKing(board, x, y, color);
-	first = *outputParamHeadOfListOfMoves;
-	if (first == NULL) {
-		DEBUG_LOGIC_PRINT("returning MOVE_SUCCESSFUL");
-		return MOVE_SUCCESSFUL;
-	}
-	//if threatened, remove non-canceling threat moves
-	if ((filter) && (ChessLogicIsCheck(board, color))) { //if color is under check
-		ChessLogicCreateBoardAfterMove(board, *first, tempBoard);
-		while (ChessLogicIsCheck(tempBoard, color)) {
-			dummyMoves = first->pNextMove;
-			free(first);
-			first = dummyMoves;
-			if (first == NULL) {
-				*outputParamHeadOfListOfMoves = first;
-				DEBUG_LOGIC_PRINT("returning MOVE_SUCCESSFUL");
-				return MOVE_SUCCESSFUL;  // there are no possible moves , but is everything is ok
-			}
-			ChessLogicCreateBoardAfterMove(board, *first, tempBoard);
-		}
-		currMove = first->pNextMove;
-		prevMove = first;
-		while (currMove != NULL) {
-			ChessLogicCreateBoardAfterMove(board, *currMove, tempBoard);
-			if (!(ChessLogicIsCheck(tempBoard, color))) {
-				prevMove->pNextMove = currMove;
-				prevMove = prevMove->pNextMove;
-				currMove = currMove->pNextMove;
-			}
-			else {
-				dummyMoves = currMove->pNextMove;
-				free(currMove);
-				currMove = dummyMoves;
-			}
-		}
-		prevMove->pNextMove = NULL;
-	}
-	// if not under check,  remove all the moves that doing them will result in check. 
-	if (filter) {		
-		ChessLogicCreateBoardAfterMove(board, *first, tempBoard);
-		while (ChessLogicIsCheck(tempBoard, color)) {
-			dummyMoves = first->pNextMove;
-			free(first);
-			first = dummyMoves;
-			if (first == NULL) {
-				*outputParamHeadOfListOfMoves = first;
-				DEBUG_LOGIC_PRINT("returning MOVE_SUCCESSFUL");
-				return MOVE_SUCCESSFUL;  // there are no possible moves , but is everything is ok
-			}
-			ChessLogicCreateBoardAfterMove(board, *first, tempBoard);
-		}
-		currMove = first->pNextMove;
-		prevMove = first;
-		while (currMove != NULL) {
-			ChessLogicCreateBoardAfterMove(board, *currMove, tempBoard);
-			if (!(ChessLogicIsCheck(tempBoard, color))) {
-				prevMove->pNextMove = currMove;
-				prevMove = prevMove->pNextMove;
-				currMove = currMove->pNextMove;
-			}
-			else
-			{
-				dummyMoves = currMove->pNextMove;
-				free(currMove);
-				currMove = dummyMoves;
-			}
-		}
-		prevMove->pNextMove = NULL;
-	}
-
-	*outputParamHeadOfListOfMoves = first;
-
-	if (*outputParamHeadOfListOfMoves != NULL) { // there are moves! 
-		DEBUG_LOGIC_PRINT("returning MOVE_SUCCESSFUL");
-		return MOVE_SUCCESSFUL;
-	}
-	DEBUG_LOGIC_PRINT("returning MOVE_SUCCESSFUL");
-	return MOVE_SUCCESSFUL;  // there are no possible moves , but is everything is ok
+	MOVE_BUFFER_RESET(&moves);
+	status = ChessLogicGetMovesPiece(&position, place, &moves, boardColor, 1);
+	if (status == MOVE_SUCCESSFUL)
+		*outputParamHeadOfListOfMoves = ChessLogicMoveBufferToList(&moves);
+	return status;
 }
 
+// the depth of a constant difficulty, the "best" difficulty deepens the search as its budget allows
 int convertDepthToInt(GAME_DIFFICULTY minimaxDpeth) {
-	int total = 0;
-	int countPieces[12] = { 0 };
 	if (minimaxDpeth == GAME_DIFFICULTY_CONSTANT_1)
 		return 1;
 	if (minimaxDpeth == GAME_DIFFICULTY_CONSTANT_2)
@@ -493,105 +403,112 @@ int convertDepthToInt(GAME_DIFFICULTY minimaxDpeth) {
 		return 3;
 	if (minimaxDpeth == GAME_DIFFICULTY_CONSTANT_4)
 		return 4;
+	return -1;
+}
+
+/* scores the root moves of color for the difficulty, returns the depth they were searched to. The best score is exact,
+   and with keepTies so are the scores of the moves that tie it. The others are only known to be lower.
+   A depth search that is stopped has no iteration to fall back on: a one ply search, too short to stop, stands in */
+int ChessLogicScoreRootMoves(GAME_DIFFICULTY minimaxDpeth, PLAYER_COLOR color, const MOVE_BUFFER* pRootMoves, int* scores, int keepTies) {
+	int depth;
+	ChessLogicTTNewSearch();
 	if (minimaxDpeth == GAME_DIFFICULTY_BEST) {
-		ChessLogicCountPieces(board, countPieces);
-		total += countPieces[0] * 3 + countPieces[1] * 14 + countPieces[2] * 8 + countPieces[3] * 14 + countPieces[4] * 27 + countPieces[5] * 8
-			+ countPieces[6] * 3 + countPieces[7] * 14 + countPieces[8] * 8 + countPieces[9] * 14 + countPieces[10] * 27 + countPieces[11] * 8;
-		return (int)(floor((log10(1000000)) / (log10(total))));
+		depth = ChessLogicIterativeDeepening(&position, color, pRootMoves, scores, keepTies);
+		ChessLogicSearchEnd();
+		return depth;
 	}
-	return -1;
+	depth = convertDepthToInt(minimaxDpeth);
+	ChessLogicSearchStart(0, 0);
+	ChessLogicSearchAllowStop();
+	if (!ChessLogicSearchRoot(&position, color, depth, pRootMoves, NULL, scores, keepTies)) {
+		depth = 1;
+		ChessLogicSearchStart(0, 0);
+		ChessLogicSearchRoot(&position, color, depth, pRootMoves, NULL, scores, keepTies);
+	}
+	ChessLogicSearchEnd();
+	return depth;
 }
 
 void ChessLogicGetBestMoves(GAME_DIFFICULTY minimaxDpeth, GAME_MOVE_PTR* moves) {
-	GAME_MOVE_PTR first;
-	GAME_MOVE_PTR currMove = NULL;
-	GAME_MOVE_PTR prevMove = NULL;	
-	GAME_MOVE_PTR dummy = NULL;
-	PLAYER_COLOR oppositeColor = PLAYER_COLOR_WHITE;
-	PLAYER_COLOR oppositeToUserColor = PLAYER_COLOR_WHITE;
-	int score = 0;	
+	MOVE_BUFFER rootMoves;
+	MOVE_BUFFER bestMoves;
+	int scores[MAX_MOVES_PER_POSITION];
+	int i;
 	int maximum = -50000;	
 	DEBUG_PRINT("difficulty=%d", minimaxDpeth);
 	assert(moves);
-	if (userColor == PLAYER_COLOR_WHITE)
-		oppositeToUserColor = PLAYER_COLOR_BLACK;
-	if (currPlayer == userColor) 
-		first = ChessInternalGetAllMoves(board,userColor,1);
-	else 
-		first = ChessInternalGetAllMoves(board, oppositeToUserColor, 1);
-	if (currPlayer == PLAYER_COLOR_WHITE)
-		oppositeColor = PLAYER_COLOR_BLACK;	
+	ChessInternalGetAllMoves(&position, currPlayer, 1, &rootMoves);
+	ChessLogicScoreRootMoves(minimaxDpeth, currPlayer, &rootMoves, scores, 1);
 
-	currMove = first;
-	prevMove = first;
-	while (currMove)
+	// keep all the moves that share the maximal score, in their original order
+	MOVE_BUFFER_RESET(&bestMoves);
+	for (i = 0; i < rootMoves.count; i++)
 	{
-
-		score = ChessMinimax(board, currMove, currPlayer, convertDepthToInt(minimaxDpeth), oppositeColor, -50000, 50000, ChessLogicFreeMovesList, ChessInternalGetAllMoves, ChessLogicCreateBoardAfterMove, ChessLogicBoardScore);
-		if (score > maximum)
-		{ // we change the first pointer of the moves_list
-			if (first != currMove) {
-				ChessLogicFreeMovesList(first);
-			}
-			first = currMove;
-			prevMove = currMove;
-			currMove = currMove->pNextMove;
-			maximum = score;
-			first->pNextMove = NULL; 
-		}
-		else if (score == maximum) {
-			prevMove->pNextMove = currMove;
-			prevMove = prevMove->pNextMove;
-			currMove = currMove->pNextMove;
-			prevMove->pNextMove = NULL;
+		if (scores[i] > maximum)
+		{
+			MOVE_BUFFER_RESET(&bestMoves);
+			maximum = scores[i];
 		}
-		else {
-			dummy = currMove->pNextMove;
-			free(currMove);
-			currMove = dummy;
-		}		
+		if (scores[i] == maximum)
+			bestMoves.moves[bestMoves.count++] = rootMoves.moves[i];
 	}
-	if(prevMove!=NULL)
-		prevMove->pNextMove = NULL;
-	*moves = first;
-	DEBUG_PRINT("list=%p", (void*)first);
+	*moves = ChessLogicMoveBufferToList(&bestMoves);
+	DEBUG_PRINT("list=%p", (void*)*moves);
+}
+
+unsigned long long ChessLogicPerft(int depth) {
+	return ChessInternalPerft(&position, currPlayer, depth);
+}
+
+unsigned long long ChessLogicPerftDivide(int depth, void(*ReportMove)(GAME_MOVE, unsigned long long)) {
+	assert(ReportMove);
+	return ChessInternalPerftDivide(&position, currPlayer, depth, ReportMove);
 }
 
 int ChessLogicGetScore(GAME_DIFFICULTY minimaxDepth, GAME_MOVE move) {
-	PLAYER_COLOR oppositeColor = PLAYER_COLOR_WHITE;	
-	if (currPlayer == PLAYER_COLOR_WHITE)
-		oppositeColor = PLAYER_COLOR_BLACK;
-	return ChessMinimax(board, &move, currPlayer, convertDepthToInt(minimaxDepth), oppositeColor, -50000, 50000, ChessLogicFreeMovesList, ChessInternalGetAllMoves, ChessLogicCreateBoardAfterMove, ChessLogicBoardScore);
+	MOVE_BUFFER rootMoves;
+	int scores[MAX_MOVES_PER_POSITION];
+	int score;
+	CHESS_MOVE packedMove = ChessLogicPackMove(&position, move);
+	if (packedMove == MOVE_NONE) {
+		PRINT_ERROR("Invalid move: <%d,%d> --> <%d,%d> newType=%d", move.origin.column, move.origin.row, move.destination.column, move.destination.row, move.newType);
+		return 0;
+	}
+	// the move is the only root move: the best score of a root search is exact, and the budget and a cancel stop
+	// the search that scores it
+	MOVE_BUFFER_RESET(&rootMoves);
+	rootMoves.moves[rootMoves.count++] = packedMove;
+	ChessLogicScoreRootMoves(minimaxDepth, currPlayer, &rootMoves, scores, 0);
+	score = scores[0];
+	// the search counts hundredths of a pawn, the score is given in pawns
+	if (score == 50000 || score == -50000)
+		return score;
+	return score / EVAL_PAWN_VALUE;
 }
 
 
 GAME_MOVE ChessLogicGetNextComputerMove() {	
-	GAME_MOVE_PTR first;
-	GAME_MOVE_PTR bestMove= NULL;
+	MOVE_BUFFER computerMoves;
 	GAME_MOVE resultMove;
 	PLAYER_COLOR oppositeColor = PLAYER_COLOR_WHITE;
-	int res = 0, maximum = -50000;	
-	first = otherMoves;
+	int scores[MAX_MOVES_PER_POSITION];
+	int i, bestMove = 0, maximum = -50000;	
 
 	if (userColor == PLAYER_COLOR_WHITE)
 		oppositeColor = PLAYER_COLOR_BLACK;
 
-	while (first)
+	ChessInternalGetAllMoves(&position, oppositeColor, 1, &computerMoves);
+	assert(computerMoves.count > 0);
+	ChessLogicScoreRootMoves(gameDifficulty, oppositeColor, &computerMoves, scores, 0);
+	for (i = 0; i < computerMoves.count; i++)
 	{
-		res = ChessMinimax(board, first, oppositeColor, convertDepthToInt(gameDifficulty), userColor, -50000, 50000, ChessLogicFreeMovesList, ChessInternalGetAllMoves, ChessLogicCreateBoardAfterMove, ChessLogicBoardScore);
-		if (res > maximum)
+		if (scores[i] > maximum)
 		{
-			bestMove = first;
-			maximum = res;			
+			bestMove = i;
+			maximum = scores[i];			
 		}
-		first = first->pNextMove;
 	}
-	resultMove.origin.column = bestMove->origin.column;
-	resultMove.origin.row = bestMove->origin.row;
-	resultMove.destination.column = bestMove->destination.column;
-	resultMove.destination.row = bestMove->destination.row;
-	resultMove.pNextMove = bestMove->pNextMove;
-	resultMove.newType =bestMove-> newType;
+	resultMove = ChessLogicUnpackMove(computerMoves.moves[bestMove]);
 
 	return resultMove;	
 
@@ -631,12 +548,7 @@ BOARD* ChessLogicGetBoardReference() {
 }
 
 void ChessLogicGetBoardCopy(BOARD* pBoard) {
-	int row, col;
-	for (col = 0; col < BOARD_SIZE; col++) {
-		for (row = 0; row < BOARD_SIZE; row++) {
-			(*pBoard)[col][row] = board[col][row];
-		}
-	}
+	ChessLogicPositionToBoard(&position, *pBoard);
 }
 
 void ChessLogicLoadCompleteBoard(BOARD loadBoard) {
@@ -648,6 +560,7 @@ void ChessLogicLoadCompleteBoard(BOARD loadBoard) {
 			VALIDATE_PIECE(currPiece);
 			board[i][j] = currPiece;
 		}
+	ChessLogicSyncPosition();
 }
 
 
@@ -703,6 +616,10 @@ int ChessLogicSetMorePieces() {
 	return 0;
 }
 
+void ChessLogicSyncPosition() {
+	ChessLogicPositionFromBoard(board, &position);
+}
+
 MOVE_STATUS ChessLogicCorrectColor(GAME_MOVE move) {
 	int x = move.origin.column;
 	int y = move.origin.row;
@@ -729,592 +646,25 @@ PLAYER_COLOR ChessLogicCheckColor(BOARD board, int x, int y) {
 }
 
 
-GAME_MOVE_PTR ChessLogicGetMovesPawn(BOARD board, int x, int y, PLAYER_COLOR color) {
+// builds a heap allocated list out of a moves buffer, for the users of the public API
+GAME_MOVE_PTR ChessLogicMoveBufferToList(const MOVE_BUFFER* pMoves) {
 	GAME_MOVE_PTR first = NULL;
-	GAME_MOVE_PTR currMove = NULL;
-	GAME_MOVE_PTR newMove = NULL;
-	PLAYER_COLOR oppositeColor = PLAYER_COLOR_WHITE;
-	if (color == PLAYER_COLOR_WHITE) {
-		oppositeColor = PLAYER_COLOR_BLACK;
-		if (ChessLogicValidPlace(x, y + 1) && board[x][y + 1] == BLANK_POSITION) { // one step forward
-			if (y + 1 != BOARD_SIZE - 1){ 
-				newMove = ChessLogicCreateMove(x, y, x, y + 1, NULL, BLANK_POSITION);
-				currMove = newMove;
-				first = currMove;
-			}
-			else{ //white promotion
-				newMove = ChessLogicCreateMove(x, y, x, y + 1, NULL, WHITE_QUEEN);
-				currMove = newMove;
-				first = currMove;
-				newMove = ChessLogicCreateMove(x, y, x, y + 1, NULL, WHITE_BISHOP);
-				currMove->pNextMove = newMove;
-				currMove = currMove->pNextMove;
-				newMove = ChessLogicCreateMove(x, y, x, y + 1, NULL, WHITE_KNIGHT);
-				currMove->pNextMove = newMove;
-				currMove = currMove->pNextMove;
-				newMove = ChessLogicCreateMove(x, y, x, y + 1, NULL, WHITE_ROOK);
-				currMove->pNextMove = newMove;
-				currMove = currMove->pNextMove;
-			}
-		}
-		// one step diagonal right, eat
-		if (ChessLogicValidPlace(x + 1, y + 1) && ChessLogicCheckColor(board, x + 1, y + 1) == oppositeColor) {
-			if (y + 1 != BOARD_SIZE - 1) {
-				newMove = ChessLogicCreateMove(x, y, x + 1, y + 1, NULL, BLANK_POSITION);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				if (first == NULL)
-					first = currMove;
-			}
-			else { //white promotion
-				newMove = ChessLogicCreateMove(x, y, x+1, y + 1, NULL, WHITE_QUEEN);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				if (first == NULL)
-					first = currMove;
-				newMove = ChessLogicCreateMove(x, y, x+1, y + 1, NULL, WHITE_BISHOP);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				newMove = ChessLogicCreateMove(x, y, x + 1, y + 1, NULL, WHITE_KNIGHT);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				newMove = ChessLogicCreateMove(x, y, x + 1, y + 1, NULL, WHITE_ROOK);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-			}
-		}
-		// one step diagonal left, eat
-		if (ChessLogicValidPlace(x - 1, y + 1) && ChessLogicCheckColor(board, x - 1, y + 1) == oppositeColor) {
-			if (y + 1 != BOARD_SIZE - 1) {
-				newMove = ChessLogicCreateMove(x, y, x - 1, y + 1, NULL, BLANK_POSITION);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				if (first == NULL)
-					first = currMove;
-			}
-			else { //white promotion
-				newMove = ChessLogicCreateMove(x, y, x - 1, y + 1, NULL, WHITE_QUEEN);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				if (first == NULL)
-					first = currMove;
-				newMove = ChessLogicCreateMove(x, y, x - 1, y + 1, NULL, WHITE_BISHOP);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				newMove = ChessLogicCreateMove(x, y, x - 1, y + 1, NULL, WHITE_KNIGHT);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				newMove = ChessLogicCreateMove(x, y, x - 1, y + 1, NULL, WHITE_ROOK);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-			}
-
-		}
-	}
-	else // color is black
-	{
-		if (ChessLogicValidPlace(x, y - 1) && board[x][y - 1] == BLANK_POSITION) { // one step backward (forward)
-			if (y  - 1 != 0){
-				newMove = ChessLogicCreateMove(x, y, x, y - 1, NULL, BLANK_POSITION);
-				currMove = newMove;
-				first = currMove;
-			}
-			else{ //black promotion
-				newMove = ChessLogicCreateMove(x, y, x, y - 1, NULL, BLACK_QUEEN);
-				currMove = newMove;
-				first = currMove;
-				newMove = ChessLogicCreateMove(x, y, x, y - 1, NULL, BLACK_BISHOP);
-				currMove->pNextMove = newMove;
-				currMove = currMove->pNextMove;
-				newMove = ChessLogicCreateMove(x, y, x, y - 1, NULL, BLACK_KNIGHT);
-				currMove->pNextMove = newMove;
-				currMove = currMove->pNextMove;
-				newMove = ChessLogicCreateMove(x, y, x, y - 1, NULL, BLACK_ROOK);
-				currMove->pNextMove = newMove;
-				currMove = currMove->pNextMove;
-
-			}
-		
-		}
-		// one step diagonal right, eat
-		if (ChessLogicValidPlace(x - 1, y - 1) && ChessLogicCheckColor(board, x - 1, y - 1) == oppositeColor) {
-			if (y - 1 != 0) {
-				newMove = ChessLogicCreateMove(x, y, x - 1, y - 1, NULL, BLANK_POSITION);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				if (first == NULL)
-					first = currMove;
-			}
-			else { //black promotion
-				newMove = ChessLogicCreateMove(x, y, x - 1, y - 1, NULL, BLACK_QUEEN);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				if (first == NULL)
-					first = currMove;
-				newMove = ChessLogicCreateMove(x, y, x - 1, y- 1, NULL, BLACK_BISHOP);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				newMove = ChessLogicCreateMove(x, y, x - 1, y - 1, NULL, BLACK_KNIGHT);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				newMove = ChessLogicCreateMove(x, y, x - 1, y - 1, NULL, BLACK_ROOK);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-			}
-		}
-		// one step diagonal left, eat
-		if (ChessLogicValidPlace(x + 1, y - 1) && ChessLogicCheckColor(board, x + 1, y - 1) == oppositeColor) {
-			if (y - 1 != 0) {
-				newMove = ChessLogicCreateMove(x, y, x + 1, y - 1, NULL, BLANK_POSITION);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				if (first == NULL)
-					first = currMove;
-			}
-			else { //black promotion
-				newMove = ChessLogicCreateMove(x, y, x + 1, y - 1, NULL, BLACK_QUEEN);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				if (first == NULL)
-					first = currMove;
-				newMove = ChessLogicCreateMove(x, y, x + 1, y - 1, NULL, BLACK_BISHOP);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				newMove = ChessLogicCreateMove(x, y, x + 1, y - 1, NULL, BLACK_KNIGHT);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-				newMove = ChessLogicCreateMove(x, y, x + 1, y - 1, NULL, BLACK_ROOK);
-				if (currMove != NULL)
-					currMove->pNextMove = newMove;
-				currMove = newMove;
-			}
-		}
+	GAME_MOVE move;
+	int i;
+	for (i = pMoves->count - 1; i >= 0; i--) {
+		move = ChessLogicUnpackMove(pMoves->moves[i]);
+		first = ChessLogicCreateMove(move.origin.column, move.origin.row, move.destination.column, move.destination.row, first, move.newType);
 	}
-	if (first != NULL)
-		if (first->pNextMove != NULL)
-			currMove->pNextMove = NULL;
 	return first;
 }
 
-GAME_MOVE_PTR ChessLogicGetMovesRook(BOARD board, int x, int y, PLAYER_COLOR color) {
-	GAME_MOVE_PTR first = NULL;
-	GAME_MOVE_PTR currMove = NULL;
-	GAME_MOVE_PTR newMove = NULL;
-	int startx = x, starty= y;	
-	PLAYER_COLOR oppositeColor = PLAYER_COLOR_WHITE;
-	if (color == PLAYER_COLOR_WHITE)
-		oppositeColor = PLAYER_COLOR_BLACK;
-
-	//up 
-	while (ChessLogicValidPlace(x, y + 1) && board[x][y + 1] == BLANK_POSITION) {
-		newMove = ChessLogicCreateMove(startx, starty, x, y + 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-		y += 1;
-	}
-	if (ChessLogicValidPlace(x, y + 1) && ChessLogicCheckColor(board, x, y + 1) == oppositeColor) { // it isnt BLANK_POSITION, try to eat
-		newMove = ChessLogicCreateMove(startx, starty, x, y + 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	//left
-	x = startx;
-	y = starty;
-	while (ChessLogicValidPlace(x - 1, y) && board[x - 1][y] == BLANK_POSITION) {
-		newMove = ChessLogicCreateMove(startx, starty, x - 1, y, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-		x -= 1;
-	}
-	if (ChessLogicValidPlace(x - 1, y) && ChessLogicCheckColor(board, x - 1, y) == oppositeColor) { // it isnt BLANK_POSITION, try to eat
-		newMove = ChessLogicCreateMove(startx, starty, x - 1, y, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	x = startx;
-	y = starty;
-	//down
-	while (ChessLogicValidPlace(x, y - 1) && board[x][y - 1] == BLANK_POSITION) {
-		newMove = ChessLogicCreateMove(startx, starty, x, y - 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-		y -= 1;
-	}
-	if (ChessLogicValidPlace(x, y - 1) && ChessLogicCheckColor(board, x, y - 1) == oppositeColor) { // it isnt BLANK_POSITION, try to eat
-		newMove = ChessLogicCreateMove(startx, starty, x, y - 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	x = startx;
-	y = starty;
-	//right
-	while (ChessLogicValidPlace(x + 1, y) && board[x + 1][y] == BLANK_POSITION) {
-		newMove = ChessLogicCreateMove(startx, starty, x + 1, y, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-		x += 1;
-	}
-	if (ChessLogicValidPlace(x + 1, y) && ChessLogicCheckColor(board, x + 1, y) == oppositeColor) { // it isnt BLANK_POSITION, try to eat
-		newMove = ChessLogicCreateMove(startx, starty, x + 1, y, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	if (first != NULL)
-		if (first->pNextMove != NULL)
-			currMove->pNextMove = NULL;
-	return first;
-}
-
-GAME_MOVE_PTR ChessLogicGetMovesKnight(BOARD board, int x, int y, PLAYER_COLOR color) {
-	GAME_MOVE_PTR first = NULL;
-	GAME_MOVE_PTR currMove = NULL;
-	GAME_MOVE_PTR newMove = NULL;
-	PLAYER_COLOR oppositeColor = PLAYER_COLOR_WHITE;
-	if (color == PLAYER_COLOR_WHITE)
-		oppositeColor = PLAYER_COLOR_BLACK;
-	// up left
-	if (ChessLogicValidPlace(x - 1, y + 2) && (board[x - 1][y + 2] == BLANK_POSITION || ChessLogicCheckColor(board, x - 1, y + 2) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x - 1, y + 2, NULL, BLANK_POSITION);
-		currMove = newMove;
-		first = currMove;
-	}
-	// up right
-	if (ChessLogicValidPlace(x + 1, y + 2) && (board[x + 1][y + 2] == BLANK_POSITION || ChessLogicCheckColor(board, x + 1, y + 2) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x + 1, y + 2, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	// down left
-	if (ChessLogicValidPlace(x - 1, y - 2) && (board[x - 1][y - 2] == BLANK_POSITION || ChessLogicCheckColor(board, x - 1, y - 2) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x - 1, y - 2, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	// down right
-	if (ChessLogicValidPlace(x + 1, y - 2) && (board[x + 1][y - 2] == BLANK_POSITION || ChessLogicCheckColor(board, x + 1, y - 2) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x + 1, y - 2, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	// left up
-	if (ChessLogicValidPlace(x - 2, y + 1) && (board[x - 2][y + 1] == BLANK_POSITION || ChessLogicCheckColor(board, x - 2, y + 1) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x - 2, y + 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	// right up
-	if (ChessLogicValidPlace(x + 2, y + 1) && (board[x + 2][y + 1] == BLANK_POSITION || ChessLogicCheckColor(board, x + 2, y + 1) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x + 2, y + 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	// left down
-	if (ChessLogicValidPlace(x - 2, y - 1) && (board[x - 2][y - 1] == BLANK_POSITION || ChessLogicCheckColor(board, x - 2, y - 1) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x - 2, y - 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	// right down
-	if (ChessLogicValidPlace(x + 2, y - 1) && (board[x + 2][y - 1] == BLANK_POSITION || ChessLogicCheckColor(board, x + 2, y - 1) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x + 2, y - 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	if (first != NULL)
-		if (first->pNextMove != NULL)
-			currMove->pNextMove = NULL;
-	return first;
+GAME_MOVE_PTR ChessLogicGetAllMovesList(CHESS_POSITION* pPosition, PLAYER_COLOR color) {
+	MOVE_BUFFER moves;
+	ChessInternalGetAllMoves(pPosition, color, 1, &moves);
+	return ChessLogicMoveBufferToList(&moves);
 }
 
 
-GAME_MOVE_PTR ChessLogicGetMovesBishop(BOARD board, int x, int y, PLAYER_COLOR color) {
-	GAME_MOVE_PTR first = NULL;
-	GAME_MOVE_PTR currMove = NULL;
-	GAME_MOVE_PTR newMove = NULL;
-	PLAYER_COLOR oppositeColor = PLAYER_COLOR_WHITE;
-	int startx = x, starty = y;	
-	if (color == PLAYER_COLOR_WHITE)
-		oppositeColor = PLAYER_COLOR_BLACK;
-
-	//up right
-	while (ChessLogicValidPlace(x + 1, y + 1) && board[x + 1][y + 1] == BLANK_POSITION) {
-		newMove = ChessLogicCreateMove(startx, starty, x + 1, y + 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-		x += 1;
-		y += 1;
-	}
-	if (ChessLogicValidPlace(x + 1, y + 1) && ChessLogicCheckColor(board, x + 1, y + 1) == oppositeColor) { // it isnt BLANK_POSITION, try to eat
-		newMove = ChessLogicCreateMove(startx, starty, x + 1, y + 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	//up left
-	x = startx;
-	y = starty;
-	while (ChessLogicValidPlace(x - 1, y + 1) && board[x - 1][y + 1] == BLANK_POSITION) {
-		newMove = ChessLogicCreateMove(startx, starty, x - 1, y + 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-		x -= 1;
-		y += 1;
-	}
-	if (ChessLogicValidPlace(x - 1, y + 1) && ChessLogicCheckColor(board, x - 1, y + 1) == oppositeColor) { // it isnt BLANK_POSITION, try to eat
-		newMove = ChessLogicCreateMove(startx, starty, x - 1, y + 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	x = startx;
-	y = starty;
-	//down left
-	while (ChessLogicValidPlace(x - 1, y - 1) && board[x - 1][y - 1] == BLANK_POSITION) {
-		newMove = ChessLogicCreateMove(startx, starty, x - 1, y - 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-		x -= 1;
-		y -= 1;
-	}
-	if (ChessLogicValidPlace(x - 1, y - 1) && ChessLogicCheckColor(board, x - 1, y - 1) == oppositeColor) { // it isnt BLANK_POSITION, try to eat
-		newMove = ChessLogicCreateMove(startx, starty, x - 1, y - 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	x = startx;
-	y = starty;
-	//down right
-	while (ChessLogicValidPlace(x + 1, y - 1) && board[x + 1][y - 1] == BLANK_POSITION) {
-		newMove = ChessLogicCreateMove(startx, starty, x + 1, y - 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-		x += 1;
-		y -= 1;
-	}
-	if (ChessLogicValidPlace(x + 1, y - 1) && ChessLogicCheckColor(board, x + 1, y - 1) == oppositeColor) { // it isnt BLANK_POSITION, try to eat
-		newMove = ChessLogicCreateMove(startx, starty, x + 1, y - 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	if (first != NULL)
-		if (first->pNextMove != NULL)
-			currMove->pNextMove = NULL;
-	return first;
-}
-
-GAME_MOVE_PTR ChessLogicGetMovesQueen(BOARD board, int x, int y, PLAYER_COLOR color) {
-	GAME_MOVE_PTR first = NULL;
-	GAME_MOVE_PTR currMove = NULL;
-	first = ChessLogicGetMovesBishop(board, x, y, color);
-	currMove = first;
-	if (currMove == NULL) {
-		first=ChessLogicGetMovesRook(board, x, y, color);
-		return first;
-	}
-	while (currMove->pNextMove != NULL)
-		currMove = currMove->pNextMove;
-	currMove->pNextMove = ChessLogicGetMovesRook(board, x, y, color);
-	return first;
-}
-
-GAME_MOVE_PTR ChessLogicGetMovesKing(BOARD board, int x, int y, PLAYER_COLOR color) {
-	GAME_MOVE_PTR first = NULL;
-	GAME_MOVE_PTR currMove = NULL;
-	GAME_MOVE_PTR newMove = NULL;
-	PLAYER_COLOR oppositeColor = PLAYER_COLOR_WHITE;
-	if (color == PLAYER_COLOR_WHITE)
-		oppositeColor = PLAYER_COLOR_BLACK;
-	if (ChessLogicValidPlace(x, y + 1) && (board[x][y + 1] == BLANK_POSITION || ChessLogicCheckColor(board, x, y + 1) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x, y + 1, NULL, BLANK_POSITION);
-		currMove = newMove;
-		first = currMove;
-	}
-	// one step left
-	if (ChessLogicValidPlace(x - 1, y) && (board[x - 1][y] == BLANK_POSITION || ChessLogicCheckColor(board, x - 1, y) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x - 1, y, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	// one step down
-	if (ChessLogicValidPlace(x, y - 1) && (board[x][y - 1] == BLANK_POSITION || ChessLogicCheckColor(board, x, y - 1) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x, y - 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	// one step right
-	if (ChessLogicValidPlace(x + 1, y) && (board[x + 1][y] == BLANK_POSITION || ChessLogicCheckColor(board, x + 1, y) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x + 1, y, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	// one step diagonal right up
-	if (ChessLogicValidPlace(x + 1, y + 1) && (board[x + 1][y + 1] == BLANK_POSITION || ChessLogicCheckColor(board, x + 1, y + 1) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x + 1, y + 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	// one step diagonal left up
-	if (ChessLogicValidPlace(x - 1, y + 1) && (board[x - 1][y + 1] == BLANK_POSITION || ChessLogicCheckColor(board, x - 1, y + 1) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x - 1, y + 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	// one step diagonal right down
-	if (ChessLogicValidPlace(x + 1, y - 1) && (board[x + 1][y - 1] == BLANK_POSITION || ChessLogicCheckColor(board, x + 1, y - 1) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x + 1, y - 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	// one step diagonal left down
-	if (ChessLogicValidPlace(x - 1, y - 1) && (board[x - 1][y - 1] == BLANK_POSITION || ChessLogicCheckColor(board, x - 1, y - 1) == oppositeColor)) {
-		newMove = ChessLogicCreateMove(x, y, x - 1, y - 1, NULL, BLANK_POSITION);
-		if (currMove != NULL)
-			currMove->pNextMove = newMove;
-		currMove = newMove;
-		if (first == NULL)
-			first = currMove;
-	}
-	if (first != NULL)
-		if (first->pNextMove != NULL)
-			currMove->pNextMove = NULL;
-	return first;
-}
-
-//filter is for filtering non-check moves or not
-GAME_MOVE_PTR ChessInternalGetAllMoves(BOARD board, PLAYER_COLOR color, int filter) {
-	BOARD_LOCATION m;
-	GAME_MOVE_PTR first = NULL;
-	GAME_MOVE_PTR currMove = NULL;
-	GAME_MOVE_PTR newMoves = NULL;
-	//calculate all possible moves
-	int x, y;
-	for (x = 0; x < BOARD_SIZE; x++) {
-		for (y = 0; y < BOARD_SIZE; y++) {
-			if (ChessLogicCheckColor(board, x, y) == color) {
-				m.column = x;
-				m.row = y;
-				ChessLogicGetMovesPiece(board, m, &newMoves, color, filter);
-				if (first == NULL)
-					first = newMoves;
-				if (currMove != NULL)
-					currMove->pNextMove = newMoves;
-				else
-					currMove = newMoves;
-				while (currMove != NULL && currMove->pNextMove != NULL)
-					currMove = currMove->pNextMove;
-			}
-		}
-	}
-	return first;
-
-}
-
-
-
 GAME_MOVE_PTR ChessLogicCreateMove(int originx, int originy, int destx, int desty, GAME_MOVE_PTR pNextMove, CHESS_PIECE_TYPE newType) {
 	GAME_MOVE_PTR newMove = NULL;
 	newMove = (GAME_MOVE_PTR)malloc(sizeof(GAME_MOVE));
@@ -1330,301 +680,3 @@ GAME_MOVE_PTR ChessLogicCreateMove(int originx, int originy, int destx, int dest
 	newMove->newType = newType;
 	return newMove;
 }
-
-
-
-
-BOARD_LOCATION ChessLogicFindKing(BOARD board, PLAYER_COLOR color) {
-	int x, y;
-	CHESS_PIECE_TYPE type = WHITE_KING;
-	BOARD_LOCATION kingLocation;
-	kingLocation.column = -1;
-	kingLocation.row = -1;	
-	if (color == PLAYER_COLOR_BLACK)
-		type = BLACK_KING;
-	for (x = 0; x < BOARD_SIZE; x++) {
-		for (y = 0; y < BOARD_SIZE; y++) {
-			if (board[x][y] == type) {
-				kingLocation.column = x;
-				kingLocation.row = y;
-			}
-		}
-	}
-	return kingLocation;
-}
-
-//returns true if player color is under check 
-int ChessLogicIsCheck(BOARD board, PLAYER_COLOR color) {
-	BOARD_LOCATION kingLoc;
-	int xKingLoc;
-	int yKingLoc;
-	int x;
-	int y;	
-	CHESS_PIECE_TYPE oppRook = WHITE_ROOK;
-	CHESS_PIECE_TYPE oppKnight = WHITE_KNIGHT;
-	CHESS_PIECE_TYPE oppBishop = WHITE_BISHOP;
-	CHESS_PIECE_TYPE oppQueen = WHITE_QUEEN;
-	CHESS_PIECE_TYPE oppPawn = WHITE_PAWN;
-	CHESS_PIECE_TYPE oppKing = WHITE_KING;	
-	if (color == PLAYER_COLOR_WHITE) {
-		oppRook = BLACK_ROOK;
-		oppKnight = BLACK_KNIGHT;
-		oppBishop = BLACK_BISHOP;
-		oppQueen = BLACK_QUEEN;
-		oppPawn = BLACK_PAWN;
-		oppKing = BLACK_KING;			
-	}
-	kingLoc = ChessLogicFindKing(board, color);
-	xKingLoc = kingLoc.column;
-	yKingLoc = kingLoc.row;
-	
-
-	//check by rook or queen:
-	x = xKingLoc + 1;
-	y = yKingLoc;
-	while (ChessLogicValidPlace(x, y) && (!(ChessLogicCheckColor(board, x, y) == color)) && (!(board[x][y] == oppPawn || board[x][y] == oppKnight || board[x][y] == oppBishop || board[x][y] == oppKing))) {
-		if (board[x][y] == oppRook || board[x][y] == oppQueen)
-			return 1;
-		x++;
-	}
-	x = xKingLoc - 1;
-	y = yKingLoc;
-	while (ChessLogicValidPlace(x, y) && (!(ChessLogicCheckColor(board, x, y) == color)) && (!(board[x][y] == oppPawn || board[x][y] == oppKnight || board[x][y] == oppBishop || board[x][y] == oppKing))) {
-		if (board[x][y] == oppRook || board[x][y] == oppQueen)
-			return 1;
-		x--;
-	}
-	x = xKingLoc;
-	y = yKingLoc - 1;
-	while (ChessLogicValidPlace(x, y) && (!(ChessLogicCheckColor(board, x, y) == color)) && (!(board[x][y] == oppPawn || board[x][y] == oppKnight || board[x][y] == oppBishop || board[x][y] == oppKing))) {
-		if (board[x][y] == oppRook || board[x][y] == oppQueen)
-			return 1;
-		y--;
-	}
-	x = xKingLoc;
-	y = yKingLoc + 1;
-	while (ChessLogicValidPlace(x, y) && (!(ChessLogicCheckColor(board, x, y) == color)) && (!(board[x][y] == oppPawn || board[x][y] == oppKnight || board[x][y] == oppBishop || board[x][y] == oppKing))) {
-		if (board[x][y] == oppRook || board[x][y] == oppQueen)
-			return 1;
-		y++;
-	}
-
-	//check by knight
-	if ((ChessLogicValidPlace(xKingLoc - 1, yKingLoc + 2) && board[xKingLoc - 1][yKingLoc + 2] == oppKnight)
-		|| (ChessLogicValidPlace(xKingLoc + 1, yKingLoc + 2) && board[xKingLoc + 1][yKingLoc + 2] == oppKnight)
-		|| (ChessLogicValidPlace(xKingLoc + 1, yKingLoc - 2) && board[xKingLoc + 1][yKingLoc - 2] == oppKnight)
-		|| (ChessLogicValidPlace(xKingLoc - 1, yKingLoc - 2) && board[xKingLoc - 1][yKingLoc - 2] == oppKnight))
-		return 1;
-	if ((ChessLogicValidPlace(xKingLoc - 2, yKingLoc + 1) && board[xKingLoc - 2][yKingLoc + 1] == oppKnight)
-		|| (ChessLogicValidPlace(xKingLoc + 2, yKingLoc + 1) && board[xKingLoc + 2][yKingLoc + 1] == oppKnight)
-		|| (ChessLogicValidPlace(xKingLoc - 2, yKingLoc - 1) && board[xKingLoc - 2][yKingLoc - 1] == oppKnight)
-		|| (ChessLogicValidPlace(xKingLoc + 2, yKingLoc - 1) && board[xKingLoc + 2][yKingLoc - 1] == oppKnight))
-		return 1;
-
-
-	//check by bishop or queen
-	x = xKingLoc + 1;
-	y = yKingLoc + 1;
-	while (ChessLogicValidPlace(x, y) && (!(ChessLogicCheckColor(board, x, y) == color)) && (!(board[x][y] == oppPawn || board[x][y] == oppKnight || board[x][y] == oppRook || board[x][y] == oppKing))) {
-		if (board[x][y] == oppBishop || board[x][y] == oppQueen)
-			return 1;
-		x++;
-		y++;
-	}
-	x = xKingLoc + 1;
-	y = yKingLoc - 1;
-	while (ChessLogicValidPlace(x, y) && (!(ChessLogicCheckColor(board, x, y) == color)) && (!(board[x][y] == oppPawn || board[x][y] == oppKnight || board[x][y] == oppRook || board[x][y] == oppKing))) {
-		if (board[x][y] == oppBishop || board[x][y] == oppQueen)
-			return 1;
-		x++;
-		y--;
-	}
-	x = xKingLoc - 1;
-	y = yKingLoc - 1;
-	while (ChessLogicValidPlace(x, y) && (!(ChessLogicCheckColor(board, x, y) == color)) && (!(board[x][y] == oppPawn || board[x][y] == oppKnight || board[x][y] == oppRook || board[x][y] == oppKing))) {
-		if (board[x][y] == oppBishop || board[x][y] == oppQueen)
-			return 1;
-		x--;
-		y--;
-	}
-	x = xKingLoc - 1;
-	y = yKingLoc + 1;
-	while (ChessLogicValidPlace(x, y) && (!(ChessLogicCheckColor(board, x, y) == color)) && (!(board[x][y] == oppPawn || board[x][y] == oppKnight || board[x][y] == oppRook || board[x][y] == oppKing))) {
-		if (board[x][y] == oppBishop || board[x][y] == oppQueen)
-			return 1;
-		x--;
-		y++;
-	}
-
-	//check by pawn
-	if (oppPawn == BLACK_PAWN && ((ChessLogicValidPlace(xKingLoc - 1, yKingLoc + 1) && board[xKingLoc - 1][yKingLoc + 1] == BLACK_PAWN) || (ChessLogicValidPlace(xKingLoc + 1, yKingLoc + 1) && board[xKingLoc + 1][yKingLoc + 1] == BLACK_PAWN)))
-		return 1;
-	if (oppPawn == WHITE_PAWN && ((ChessLogicValidPlace(xKingLoc - 1, yKingLoc - 1) && board[xKingLoc - 1][yKingLoc - 1] == WHITE_PAWN) || (ChessLogicValidPlace(xKingLoc + 1, yKingLoc - 1) && board[xKingLoc + 1][yKingLoc - 1] == WHITE_PAWN)))
-		return 1;
-
-	//check by king
-	if ((ChessLogicValidPlace(xKingLoc - 1, yKingLoc - 1) && board[xKingLoc - 1][yKingLoc - 1] == oppKing)
-		|| (ChessLogicValidPlace(xKingLoc + 1, yKingLoc - 1) && board[xKingLoc + 1][yKingLoc - 1] == oppKing)
-		|| (ChessLogicValidPlace(xKingLoc + 1, yKingLoc + 1) && board[xKingLoc + 1][yKingLoc + 1] == oppKing)
-		|| (ChessLogicValidPlace(xKingLoc - 1, yKingLoc + 1) && board[xKingLoc - 1][yKingLoc + 1] == oppKing))
-		return 1;
-	if ((ChessLogicValidPlace(xKingLoc - 1, yKingLoc) && board[xKingLoc - 1][yKingLoc] == oppKing)
-		|| (ChessLogicValidPlace(xKingLoc + 1, yKingLoc) && board[xKingLoc + 1][yKingLoc] == oppKing)
-		|| (ChessLogicValidPlace(xKingLoc, yKingLoc + 1) && board[xKingLoc][yKingLoc + 1] == oppKing)
-		|| (ChessLogicValidPlace(xKingLoc, yKingLoc - 1) && board[xKingLoc][yKingLoc - 1] == oppKing))
-		return 1;
-
-	return 0;
-}
-
-//returns true if player color is under checkmate 
-int ChessLogicIsMate(BOARD board, PLAYER_COLOR color) {
-	BOARD_LOCATION kingLocation;
-	PLAYER_COLOR oppositeColor = PLAYER_COLOR_BLACK;
-	BOARD tempBoard;
-	int kingEaten;
-	GAME_MOVE_PTR playerMoves, counterMoves, dummyplayerMoves, dummycounterMoves; // how can COLOR respond	
-	if (color == PLAYER_COLOR_BLACK)
-		oppositeColor = PLAYER_COLOR_WHITE;	
-	playerMoves = ChessInternalGetAllMoves(board, color,1);		
-	dummyplayerMoves = playerMoves;
-	while (playerMoves != NULL) {
-		kingEaten = 0;
-		ChessLogicCreateBoardAfterMove(board, *playerMoves, tempBoard);
-		counterMoves = ChessInternalGetAllMoves(tempBoard, oppositeColor,0); // *** need to do free malloc ** //
-		dummycounterMoves = counterMoves;
-		kingLocation = ChessLogicFindKing(tempBoard, color);
-		while (counterMoves != NULL) {
-			if (counterMoves->destination.column == kingLocation.column && counterMoves->destination.row == kingLocation.row) {
-				kingEaten = 1;
-				break;
-			}			
-			counterMoves = counterMoves->pNextMove;
-		}
-		ChessLogicFreeMovesList(dummycounterMoves);		
-		if (!kingEaten) {				
-			ChessLogicFreeMovesList(dummyplayerMoves);
-			return 0;
-		}
-		playerMoves = playerMoves->pNextMove;
-	}
-	ChessLogicFreeMovesList(dummyplayerMoves);	
-	return 1;
-}
-
-void ChessLogicCreateBoardAfterMove(BOARD board, GAME_MOVE move, BOARD newBoard) {
-	int x, y;
-	for (x = 0; x < BOARD_SIZE; x++) {
-		for (y = 0; y < BOARD_SIZE; y++) {
-			newBoard[x][y] = board[x][y];
-		}
-	}
-
-	// perform the actual move
-		// promotion
-	if (board[move.origin.column][move.origin.row] == WHITE_PAWN && move.destination.row == BOARD_SIZE - 1) { //default promotion
-		if (move.newType == BLANK_POSITION) {
-			move.newType = WHITE_QUEEN;
-			
-		}
-		newBoard[move.destination.column][move.destination.row] = move.newType;
-	}
-	else if (board[move.origin.column][move.origin.row] == BLACK_PAWN && move.destination.row == 0) { //default promotion
-		if (move.newType == BLANK_POSITION) {
-			move.newType = BLACK_QUEEN;
-			
-		}
-		newBoard[move.destination.column][move.destination.row] = move.newType;
-	}
-		// not a promotion
-	else
-	{
-		newBoard[move.destination.column][move.destination.row] = board[move.origin.column][move.origin.row];
-	}
-	newBoard[move.origin.column][move.origin.row] = BLANK_POSITION;
-
-
-	/*
-	if (board[move.origin.column][move.origin.row] == WHITE_PAWN && move.newType == BLANK_POSITION && move.destination.row == BOARD_SIZE - 1) //default promotion correction
-		move.newType = WHITE_QUEEN;
-	if (board[move.origin.column][move.origin.row] == BLACK_PAWN && move.newType == BLANK_POSITION &&  move.destination.row == 0) //default promotion correction
-		move.newType = BLACK_QUEEN;
-	if (move.newType == BLANK_POSITION)
-		newBoard[move.destination.column][move.destination.row] = board[move.origin.column][move.origin.row];
-	else
-		newBoard[move.destination.column][move.destination.row] = move.newType;
-	newBoard[move.origin.column][move.origin.row] = BLANK_POSITION;
-}
-*/
-}
-
-
-/* Mate score: 50000,-50000   Tie score: 25000,-25000 */
-int ChessLogicBoardScore(BOARD board, PLAYER_COLOR color) {
-	int count_black = 0, count_white = 0, result = 0, flagCheckColor = 0, flagCheckOpposite = 0;
-	int i, j;
-	GAME_MOVE_PTR colorMoves = NULL;
-	GAME_MOVE_PTR oppositeMoves = NULL;
-	PLAYER_COLOR oppositeColor = PLAYER_COLOR_WHITE;
-	if (color == PLAYER_COLOR_WHITE)
-		oppositeColor = PLAYER_COLOR_BLACK;
-
-	// checks mate
-	if (ChessLogicIsMate(board, color)) // if color is under mate
-		return -50000;
-	if (ChessLogicIsMate(board, oppositeColor))  // the opponent is under mate, color wins
-		return 50000;
-	//check
-	if (ChessLogicIsCheck(board, color))
-		flagCheckColor = 1;
-	if (ChessLogicIsCheck(board, oppositeColor))
-		flagCheckOpposite = 1;
-	colorMoves = ChessInternalGetAllMoves(board, color,1);
-	oppositeMoves = ChessInternalGetAllMoves(board, oppositeColor,1);
-	// tie
-	if (flagCheckColor == 0 && colorMoves == NULL) {
-		//ChessLogicFreeMovesList(oppositeMoves);
-		return -250000;
-	}
-	if (flagCheckOpposite == 0 && oppositeMoves == NULL) {
-		//	ChessLogicFreeMovesList(colorMoves);
-		return 25000;
-	}
-
-	ChessLogicFreeMovesList(colorMoves);
-	ChessLogicFreeMovesList(oppositeMoves);
-
-
-	for (i = 0; i < BOARD_SIZE; i++)
-		for (j = 0; j < BOARD_SIZE; j++) {
-			if (board[i][j] == WHITE_PAWN)
-				count_white += 1;
-			else if (board[i][j] == WHITE_KNIGHT)
-				count_white += 3;
-			else if (board[i][j] == WHITE_BISHOP)
-				count_white += 3;
-			else if (board[i][j] == WHITE_ROOK)
-				count_white += 5;
-			else if (board[i][j] == WHITE_QUEEN)
-				count_white += 9;
-			else if (board[i][j] == WHITE_KING)
-				count_white += 400;
-			else if (board[i][j] == BLACK_PAWN)
-				count_black += 1;
-			else if (board[i][j] == BLACK_KNIGHT)
-				count_black += 3;
-			else if (board[i][j] == BLACK_BISHOP)
-				count_black += 3;
-			else if (board[i][j] == BLACK_ROOK)
-				count_black += 5;
-			else if (board[i][j] == BLACK_QUEEN)
-				count_black += 9;
-			else if (board[i][j] == BLACK_KING)
-				count_black += 400;
-		}
-		result = count_white - count_black;
-		if (color == PLAYER_COLOR_BLACK)
-			result = result * -1;
-
-		return result;
-}
@@ -13,6 +13,30 @@ void ChessLogicSetGameMode(GAME_MODE);
 void ChessLogicSetDifficulty(GAME_DIFFICULTY);
 void ChessLogicSetUserColor(PLAYER_COLOR);
 void ChessLogicSetNextPlayer(PLAYER_COLOR);
+/* Transposition table size in megabytes (rounded down to a power of two entries), returns 0 if it cant be allocated.
+   Should be called at startup, the table is emptied. Without a call the table gets a default size at the first search */
+int ChessLogicSetHashSize(unsigned int megabytes);
+/* Budget of the "best" difficulty: the search goes one ply deeper at a time until the time (milliseconds)
+   or the node budget runs out, and plays the deepest completed search. 0 means no limit of that kind */
+void ChessLogicSetSearchBudget(unsigned int milliseconds, unsigned long long nodes);
+/* Number of search threads (1 to 64), returns 0 if out of range. A depth search spreads its root moves over
+   them, the "best" difficulty runs helper threads beside its own. A search of a given depth finds the same
+   moves with any number of threads, more threads only get there sooner */
+int ChessLogicSetThreads(int threads);
+/* Deepest iteration of the "best" difficulty (1 to 32, 0 for no limit), returns 0 if out of range */
+int ChessLogicSetSearchDepth(int depth);
+/* Switches search features (SEARCH_FEATURE, or'ed) on or off */
+void ChessLogicSetSearchFeature(int features, int enabled);
+/* The id of the running computer move search, or of the next one while none runs. Read it before starting the search
+   to be able to stop it */
+unsigned int ChessLogicGetSearchId(void);
+/* Stops the search of the id. Safe to call from any thread (a UI thread, a watchdog) while another thread searches:
+   the search returns within a few thousand nodes, with the moves of its last completed iteration, or of a one ply
+   search when a depth search was stopped. A search stopped before it started returns after its first iteration.
+   Returns 0, and stops nothing, when that search already ended.
+   For programs that embed the logic and search on a thread of their own: the CLI and the GUI search on their only
+   thread and never call it */
+int ChessLogicStopSearch(unsigned int searchId);
 /* resets settings to defaults */
 void ChessLogicResetDefaultSettings();
 
@@ -37,7 +61,15 @@ void ChessLogicGetBestMoves(GAME_DIFFICULTY, GAME_MOVE_PTR* outputParamHeadOfLis
 
 void ChessLogicFreeMovesList(GAME_MOVE_PTR headOfMovesList);
 
+/* The score of a move of the next player searched at a difficulty, in pawns: 50000 wins by mate, -50000 loses */
 int ChessLogicGetScore(GAME_DIFFICULTY, GAME_MOVE);
+/* Nodes and cutoffs of the last search */
+void ChessLogicGetSearchStats(SEARCH_STATS*);
+
+/* Perft: the number of leaves of the legal move tree of the next player, depth plies deep */
+unsigned long long ChessLogicPerft(int depth);
+/* Perft divide: reports every legal move of the next player with its perft count below it, returns the total */
+unsigned long long ChessLogicPerftDivide(int depth, void(*ReportMove)(GAME_MOVE, unsigned long long));
 GAME_MOVE ChessLogicGetNextComputerMove();
 MOVE_STATUS ChessLogicPerformNextComputerMove(GAME_MOVE);
 void ChessLogicAdvanceNextPlayer();
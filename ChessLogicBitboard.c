@@ -0,0 +1,204 @@
+#include "ChessCommonDefs.h"
+#include "ChessLogicProtected.h"
+
+#define BITBOARD_COLUMN_A	((BITBOARD)0x00000000000000FFULL)
+#define BITBOARD_COLUMN_H	((BITBOARD)0xFF00000000000000ULL)
+#define BITBOARD_EDGES		(BITBOARD_ROW_1 | BITBOARD_ROW_8 | BITBOARD_COLUMN_A | BITBOARD_COLUMN_H)
+
+#define ROOK_TABLE_SIZE		102400	// the sum over the squares of 2 ^ (bits in the rook mask)
+#define BISHOP_TABLE_SIZE	5248
+
+/* Shifting a set by +-8 moves it a column, so pieces that fall off the board simply leave the 64 bits.
+   Shifting by +-1 moves it a row and wraps between columns, so the destination is masked:
+   everything that moved up may not land on row 1, everything that moved down may not land on row 8 */
+#define NOT_ROW_1			(~BITBOARD_ROW_1)
+#define NOT_ROW_8			(~BITBOARD_ROW_8)
+#define NOT_ROWS_1_2		(~(BITBOARD_ROW_1 | (BITBOARD_ROW_1 << 1)))
+#define NOT_ROWS_7_8		(~(BITBOARD_ROW_8 | (BITBOARD_ROW_8 >> 1)))
+
+#define SHIFT_NORTH(bb)		(((bb) << 1) & NOT_ROW_1)
+#define SHIFT_SOUTH(bb)		(((bb) >> 1) & NOT_ROW_8)
+#define SHIFT_EAST(bb)		((bb) << 8)
+#define SHIFT_WEST(bb)		((bb) >> 8)
+#define SHIFT_NORTH_EAST(bb)	(((bb) << 9) & NOT_ROW_1)
+#define SHIFT_NORTH_WEST(bb)	(((bb) >> 7) & NOT_ROW_1)
+#define SHIFT_SOUTH_EAST(bb)	(((bb) << 7) & NOT_ROW_8)
+#define SHIFT_SOUTH_WEST(bb)	(((bb) >> 9) & NOT_ROW_8)
+
+/* walks a ray one step at a time, keeping only the rays that are still on empty squares */
+#define SLIDE(attacks, origins, empty, SHIFT)	{			\
+	BITBOARD ray = SHIFT(origins);							\
+	while (ray) {											\
+		(attacks) |= ray;									\
+		ray = SHIFT(ray & (empty));							\
+	}														\
+}
+
+/* GLOBAL DATA */
+BITBOARD knightAttacks[NUM_OF_SQUARES];
+BITBOARD kingAttacks[NUM_OF_SQUARES];
+BITBOARD pawnAttacks[PLAYER_COLOR_NUM][NUM_OF_SQUARES];
+SLIDER_MAGIC rookMagics[NUM_OF_SQUARES];
+SLIDER_MAGIC bishopMagics[NUM_OF_SQUARES];
+
+/* LOCAL DATA */
+/* the generator starts again on every column from a seed that finds all its magics in few tries */
+static const uint64_t magicSeeds[BOARD_SIZE] = { 476, 2077, 2633, 696, 42, 1320, 974, 30 };
+static BITBOARD rookTable[ROOK_TABLE_SIZE];
+static BITBOARD bishopTable[BISHOP_TABLE_SIZE];
+
+/* PRIVATE METHODS DECLARATIONS */
+BITBOARD* ChessLogicInitSlider(SLIDER_MAGIC*, int, BITBOARD, BITBOARD*, BITBOARD(*)(BITBOARD, BITBOARD), uint64_t*); // fills the table of one square, returns where the next one starts
+
+/* PUBLIC METHODS IMPLEMENTATIONS */
+
+/* the tables of one square are the set functions below applied to that square alone */
+void ChessLogicInitAttacks() {
+	static int isInitialized = 0;
+	uint64_t state = 0;
+	BITBOARD* pRookNext = rookTable;
+	BITBOARD* pBishopNext = bishopTable;
+	BITBOARD rookEdges;
+	int square;
+	PLAYER_COLOR color;
+	if (isInitialized)
+		return;
+	for (square = 0; square < NUM_OF_SQUARES; square++) {
+		if (SQUARE_ROW(square) == 0)
+			state = magicSeeds[SQUARE_COLUMN(square)];
+		// the last square of a ray never blocks anything, the edges the rook moves along are part of its rays
+		rookEdges = ((BITBOARD_ROW_1 | BITBOARD_ROW_8) & ~(BITBOARD_ROW_1 << SQUARE_ROW(square)))
+			| ((BITBOARD_COLUMN_A | BITBOARD_COLUMN_H) & ~(BITBOARD_COLUMN_A << (SQUARE_COLUMN(square) * BOARD_SIZE)));
+		pRookNext = ChessLogicInitSlider(&rookMagics[square], square, ChessLogicRookAttacks(SQUARE_BIT(square), BITBOARD_EMPTY) & ~rookEdges, pRookNext, ChessLogicRookAttacks, &state);
+		pBishopNext = ChessLogicInitSlider(&bishopMagics[square], square, ChessLogicBishopAttacks(SQUARE_BIT(square), BITBOARD_EMPTY) & ~BITBOARD_EDGES, pBishopNext, ChessLogicBishopAttacks, &state);
+
+		knightAttacks[square] = ChessLogicKnightAttacks(SQUARE_BIT(square));
+		kingAttacks[square] = ChessLogicKingAttacks(SQUARE_BIT(square));
+		for (color = PLAYER_COLOR_WHITE; color < PLAYER_COLOR_NUM; color++)
+			pawnAttacks[color][square] = ChessLogicPawnAttacks(SQUARE_BIT(square), color);
+	}
+	isInitialized = 1;
+}
+
+BITBOARD ChessLogicRookAttacksFrom(int square, BITBOARD occupied) {
+	return ROOK_ATTACKS(square, occupied);
+}
+
+BITBOARD ChessLogicBishopAttacksFrom(int square, BITBOARD occupied) {
+	return BISHOP_ATTACKS(square, occupied);
+}
+
+#ifndef __GNUC__
+int ChessLogicBitboardPopCount(BITBOARD bb) {
+	int count = 0;
+	while (bb) {
+		bb &= bb - 1;
+		count++;
+	}
+	return count;
+}
+
+int ChessLogicBitboardLsb(BITBOARD bb) {
+	int square = 0;
+	while (!(bb & 1)) {
+		bb >>= 1;
+		square++;
+	}
+	return square;
+}
+#endif
+
+BITBOARD ChessLogicPawnAttacks(BITBOARD pawns, PLAYER_COLOR color) {
+	if (color == PLAYER_COLOR_WHITE)
+		return SHIFT_NORTH_EAST(pawns) | SHIFT_NORTH_WEST(pawns);
+	return SHIFT_SOUTH_EAST(pawns) | SHIFT_SOUTH_WEST(pawns);
+}
+
+BITBOARD ChessLogicKnightAttacks(BITBOARD knights) {
+	return (((knights << 10) | (knights >> 6)) & NOT_ROWS_1_2)	// two rows up, one column right/left
+		| (((knights << 17) | (knights >> 15)) & NOT_ROW_1)		// one row up, two columns right/left
+		| (((knights << 6) | (knights >> 10)) & NOT_ROWS_7_8)	// two rows down
+		| (((knights << 15) | (knights >> 17)) & NOT_ROW_8);	// one row down
+}
+
+BITBOARD ChessLogicKingAttacks(BITBOARD kings) {
+	BITBOARD row = kings | SHIFT_EAST(kings) | SHIFT_WEST(kings);
+	return (row | SHIFT_NORTH(row) | SHIFT_SOUTH(row)) & ~kings;
+}
+
+BITBOARD ChessLogicRookAttacks(BITBOARD rooks, BITBOARD occupied) {
+	BITBOARD attacks = BITBOARD_EMPTY;
+	BITBOARD empty = ~occupied;
+	SLIDE(attacks, rooks, empty, SHIFT_NORTH);
+	SLIDE(attacks, rooks, empty, SHIFT_SOUTH);
+	SLIDE(attacks, rooks, empty, SHIFT_EAST);
+	SLIDE(attacks, rooks, empty, SHIFT_WEST);
+	return attacks;
+}
+
+BITBOARD ChessLogicBishopAttacks(BITBOARD bishops, BITBOARD occupied) {
+	BITBOARD attacks = BITBOARD_EMPTY;
+	BITBOARD empty = ~occupied;
+	SLIDE(attacks, bishops, empty, SHIFT_NORTH_EAST);
+	SLIDE(attacks, bishops, empty, SHIFT_NORTH_WEST);
+	SLIDE(attacks, bishops, empty, SHIFT_SOUTH_EAST);
+	SLIDE(attacks, bishops, empty, SHIFT_SOUTH_WEST);
+	return attacks;
+}
+
+/* PRIVATE METHODS IMPLEMENTATIONS */
+
+/* Every subset of the mask is a possible set of blockers, and gets the attacks the slow ray walk finds for it.
+   With PEXT the blockers are the index themselves. Otherwise a magic is searched: a number that multiplies
+   every subset into a distinct index in its top bits, or into the index of a subset with the same attacks.
+   Sparse random numbers find one in a few tries, the generator is seeded the same way every run */
+BITBOARD* ChessLogicInitSlider(SLIDER_MAGIC* pMagic, int square, BITBOARD mask, BITBOARD* pTable, BITBOARD(*SliderAttacks)(BITBOARD, BITBOARD), uint64_t* pState) {
+	BITBOARD blockers[1 << 12];
+	BITBOARD attacks[1 << 12];
+	int bits = BITBOARD_POPCOUNT(mask);
+	int size = 1 << bits;
+	int i;
+	BITBOARD subset = BITBOARD_EMPTY;
+#ifndef USE_PEXT
+	int tried[1 << 12]; // the try that last wrote each index
+	int tries = 0;
+	unsigned int index;
+#endif
+
+	pMagic->mask = mask;
+	pMagic->shift = NUM_OF_SQUARES - bits;
+	pMagic->attacks = pTable;
+	// walks all the subsets of the mask (carry rippler)
+	for (i = 0; i < size; i++) {
+		blockers[i] = subset;
+		attacks[i] = SliderAttacks(SQUARE_BIT(square), subset);
+		subset = (subset - mask) & mask;
+	}
+#ifdef USE_PEXT
+	pMagic->magic = 0;
+	for (i = 0; i < size; i++)
+		pTable[SLIDER_INDEX(pMagic, blockers[i])] = attacks[i];
+#else
+	for (i = 0; i < size; i++)
+		tried[i] = 0;
+	for (i = 0; i < size; ) {
+		if (i == 0) {
+			tries++;
+			do
+				pMagic->magic = ChessLogicNextRandom(pState) & ChessLogicNextRandom(pState) & ChessLogicNextRandom(pState);
+			while (BITBOARD_POPCOUNT((mask * pMagic->magic) >> 56) < 6); // too few bits reach the index
+		}
+		index = (unsigned int)SLIDER_INDEX(pMagic, blockers[i]);
+		if (tried[index] != tries) {
+			tried[index] = tries;
+			pTable[index] = attacks[i];
+		}
+		else if (pTable[index] != attacks[i]) {
+			i = 0; // two subsets with different attacks collide, the next magic
+			continue;
+		}
+		i++;
+	}
+#endif
+	return pTable + size;
+}
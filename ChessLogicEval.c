@@ -0,0 +1,188 @@
+#include "ChessCommonDefs.h"
+#include "ChessLogicProtected.h"
+
+/* Static evaluation, in hundredths of a pawn. Every piece is worth its material plus a piece-square bonus,
+   once for the middlegame and once for the endgame. The position keeps the sums of both colors up to date
+   as moves are made and unmade, and the score blends the two sums by the material left on the board */
+
+/* GLOBAL DATA */
+int evalMidgame[NUM_OF_PIECE_TYPES][NUM_OF_SQUARES];
+int evalEndgame[NUM_OF_PIECE_TYPES][NUM_OF_SQUARES];
+const int evalPhase[NUM_OF_PIECE_TYPES] = { 0, 0, 1, 1, 2, 4, 0, 0, 1, 1, 2, 4, 0 };
+
+/* LOCAL DATA */
+/* material value of every CHESS_PIECE_TYPE */
+static const int pieceValues[NUM_OF_PIECE_TYPES] = { 0, 100, 300, 300, 500, 900, 40000, 100, 300, 300, 500, 900, 40000 };
+
+/* Piece-square tables of the white pieces, as the board is drawn: the 8th row first, each row from column a to h.
+   The black pieces use them upside down. Indexed by the white CHESS_PIECE_TYPE - WHITE_PAWN */
+static const int midgameTables[NUM_OF_COLORLESS_PIECE_TYPES][NUM_OF_SQUARES] =
+{
+	{	// pawn
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		 50,  50,  50,  50,  50,  50,  50,  50,
+		 10,  10,  20,  30,  30,  20,  10,  10,
+		  5,   5,  10,  25,  25,  10,   5,   5,
+		  0,   0,   0,  20,  20,   0,   0,   0,
+		  5,  -5, -10,   0,   0, -10,  -5,   5,
+		  5,  10,  10, -20, -20,  10,  10,   5,
+		  0,   0,   0,   0,   0,   0,   0,   0
+	},
+	{	// bishop
+		-20, -10, -10, -10, -10, -10, -10, -20,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-10,   0,   5,  10,  10,   5,   0, -10,
+		-10,   5,   5,  10,  10,   5,   5, -10,
+		-10,   0,  10,  10,  10,  10,   0, -10,
+		-10,  10,  10,  10,  10,  10,  10, -10,
+		-10,   5,   0,   0,   0,   0,   5, -10,
+		-20, -10, -10, -10, -10, -10, -10, -20
+	},
+	{	// knight
+		-50, -40, -30, -30, -30, -30, -40, -50,
+		-40, -20,   0,   0,   0,   0, -20, -40,
+		-30,   0,  10,  15,  15,  10,   0, -30,
+		-30,   5,  15,  20,  20,  15,   5, -30,
+		-30,   0,  15,  20,  20,  15,   0, -30,
+		-30,   5,  10,  15,  15,  10,   5, -30,
+		-40, -20,   0,   5,   5,   0, -20, -40,
+		-50, -40, -30, -30, -30, -30, -40, -50
+	},
+	{	// rook
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  5,  10,  10,  10,  10,  10,  10,   5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		  0,   0,   0,   5,   5,   0,   0,   0
+	},
+	{	// queen
+		-20, -10, -10,  -5,  -5, -10, -10, -20,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-10,   0,   5,   5,   5,   5,   0, -10,
+		 -5,   0,   5,   5,   5,   5,   0,  -5,
+		  0,   0,   5,   5,   5,   5,   0,  -5,
+		-10,   5,   5,   5,   5,   5,   0, -10,
+		-10,   0,   5,   0,   0,   0,   0, -10,
+		-20, -10, -10,  -5,  -5, -10, -10, -20
+	},
+	{	// king: behind its pawns
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-20, -30, -30, -40, -40, -30, -30, -20,
+		-10, -20, -20, -20, -20, -20, -20, -10,
+		 20,  20,   0,   0,   0,   0,  20,  20,
+		 20,  30,  10,   0,   0,  10,  30,  20
+	}
+};
+
+static const int endgameTables[NUM_OF_COLORLESS_PIECE_TYPES][NUM_OF_SQUARES] =
+{
+	{	// pawn: the closer to promotion the better
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		 80,  80,  80,  80,  80,  80,  80,  80,
+		 50,  50,  50,  50,  50,  50,  50,  50,
+		 30,  30,  30,  30,  30,  30,  30,  30,
+		 15,  15,  15,  15,  15,  15,  15,  15,
+		  5,   5,   5,   5,   5,   5,   5,   5,
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  0,   0,   0,   0,   0,   0,   0,   0
+	},
+	{	// bishop
+		-15, -10, -10, -10, -10, -10, -10, -15,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-10,   0,   5,   5,   5,   5,   0, -10,
+		-10,   0,   5,  10,  10,   5,   0, -10,
+		-10,   0,   5,  10,  10,   5,   0, -10,
+		-10,   0,   5,   5,   5,   5,   0, -10,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-15, -10, -10, -10, -10, -10, -10, -15
+	},
+	{	// knight
+		-40, -30, -20, -20, -20, -20, -30, -40,
+		-30, -15,   0,   0,   0,   0, -15, -30,
+		-20,   0,  10,  15,  15,  10,   0, -20,
+		-20,   5,  15,  20,  20,  15,   5, -20,
+		-20,   0,  15,  20,  20,  15,   0, -20,
+		-20,   5,  10,  15,  15,  10,   5, -20,
+		-30, -15,   0,   5,   5,   0, -15, -30,
+		-40, -30, -20, -20, -20, -20, -30, -40
+	},
+	{	// rook
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		 15,  15,  15,  15,  15,  15,  15,  15,
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  0,   0,   0,   0,   0,   0,   0,   0
+	},
+	{	// queen
+		-20, -10, -10,  -5,  -5, -10, -10, -20,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-10,   0,   5,  10,  10,   5,   0, -10,
+		 -5,   0,  10,  15,  15,  10,   0,  -5,
+		 -5,   0,  10,  15,  15,  10,   0,  -5,
+		-10,   0,   5,  10,  10,   5,   0, -10,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-20, -10, -10,  -5,  -5, -10, -10, -20
+	},
+	{	// king: in the center, where it helps the pawns
+		-50, -40, -30, -20, -20, -30, -40, -50,
+		-30, -20, -10,   0,   0, -10, -20, -30,
+		-30, -10,  20,  30,  30,  20, -10, -30,
+		-30, -10,  30,  40,  40,  30, -10, -30,
+		-30, -10,  30,  40,  40,  30, -10, -30,
+		-30, -10,  20,  30,  30,  20, -10, -30,
+		-30, -30,   0,   0,   0,   0, -30, -30,
+		-50, -30, -30, -30, -30, -30, -30, -50
+	}
+};
+
+/* PUBLIC METHODS IMPLEMENTATIONS */
+
+void ChessLogicInitEval() {
+	static int isInitialized = 0;
+	CHESS_PIECE_TYPE type;
+	int square, row, table;
+	if (isInitialized)
+		return;
+	for (type = WHITE_PAWN; type < NUM_OF_PIECE_TYPES; type++) {
+		table = (PIECE_COLOR(type) == PLAYER_COLOR_WHITE) ? type - WHITE_PAWN : type - BLACK_PAWN;
+		for (square = 0; square < NUM_OF_SQUARES; square++) {
+			row = (PIECE_COLOR(type) == PLAYER_COLOR_WHITE) ? BOARD_SIZE - 1 - SQUARE_ROW(square) : SQUARE_ROW(square);
+			evalMidgame[type][square] = pieceValues[type] + midgameTables[table][row * BOARD_SIZE + SQUARE_COLUMN(square)];
+			evalEndgame[type][square] = pieceValues[type] + endgameTables[table][row * BOARD_SIZE + SQUARE_COLUMN(square)];
+		}
+	}
+	isInitialized = 1;
+}
+
+/* The static score of a position from the view of color: a read of the sums the position keeps. It never
+   generates moves, the search tells mates and ties apart before it asks for a score */
+int ChessLogicBoardScore(CHESS_POSITION* pPosition, PLAYER_COLOR color) {
+	int phase = (pPosition->phase < EVAL_MAX_PHASE) ? pPosition->phase : EVAL_MAX_PHASE; // promotions may add material
+	int midgame = pPosition->midgame[PLAYER_COLOR_WHITE] - pPosition->midgame[PLAYER_COLOR_BLACK];
+	int endgame = pPosition->endgame[PLAYER_COLOR_WHITE] - pPosition->endgame[PLAYER_COLOR_BLACK];
+	int result = (midgame * phase + endgame * (EVAL_MAX_PHASE - phase)) / EVAL_MAX_PHASE;
+	if (color == PLAYER_COLOR_BLACK)
+		result = result * -1;
+	return result;
+}
+
+int ChessLogicPieceValue(CHESS_PIECE_TYPE type) {
+	return pieceValues[type];
+}
+
+// the material a move wins: the piece it eats, and what a promoted pawn gains over a pawn
+int ChessLogicMoveGain(CHESS_POSITION* pPosition, CHESS_MOVE move) {
+	int gain = pieceValues[POSITION_PIECE_AT(pPosition, MOVE_DESTINATION(move))];
+	if (MOVE_IS_PROMOTION(move))
+		gain += pieceValues[MOVE_PROMOTION_TYPE(move)] - pieceValues[WHITE_PAWN];
+	return gain;
+}
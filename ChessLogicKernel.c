@@ -0,0 +1,36 @@
+#include "ChessCommonDefs.h"
+#include "ChessLogicProtected.h"
+
+/* The chess search kernel: ChessMinimax with its callbacks bound at compile time. The generic algorithm calls
+   the move generator, the make and unmake of a move and the static score through pointers at every node, and
+   passes them down every recursive call. Here they are direct calls, the per-thread state is the SEARCH_CONTEXT,
+   and the body is compiled once for every root color (ChessLogicKernelBody.h), so the tests of which side is
+   the maximum are folded by the compiler. GenericMinimaxAlgorithm.c compiles the same body with its callbacks,
+   it stays the fallback, built with GENERIC_MINIMAX */
+
+/* the chess functions, called directly */
+#define KERNEL_GET_ALL_MOVES(pPosition, color, pMoves)	ChessInternalGetAllMoves(pPosition, color, 1, pMoves)
+#define KERNEL_GET_CAPTURES(pPosition, color, pMoves)	ChessInternalGetCaptures(pPosition, color, pMoves)
+#define KERNEL_MAKE_MOVE(pPosition, move, pUndo)		ChessLogicMakeMove(pPosition, move, pUndo)
+#define KERNEL_UNMAKE_MOVE(pPosition, pUndo)			ChessLogicUnmakeMove(pPosition, pUndo)
+#define KERNEL_BOARD_SCORE(pPosition)					ChessLogicBoardScore(pPosition, KERNEL_COLOR)
+
+#define KERNEL_COLOR			PLAYER_COLOR_WHITE
+#define KERNEL_FUNCTION(name)	name##White
+#include "ChessLogicKernelBody.h"
+#undef KERNEL_COLOR
+#undef KERNEL_FUNCTION
+
+#define KERNEL_COLOR			PLAYER_COLOR_BLACK
+#define KERNEL_FUNCTION(name)	name##Black
+#include "ChessLogicKernelBody.h"
+#undef KERNEL_COLOR
+#undef KERNEL_FUNCTION
+
+/* PUBLIC METHODS IMPLEMENTATIONS */
+
+int ChessLogicKernelSearch(SEARCH_CONTEXT* pContext, CHESS_MOVE move, PLAYER_COLOR color, int depth, PLAYER_COLOR sideToMove, int alpha, int beta) {
+	if (color == PLAYER_COLOR_WHITE)
+		return ChessKernelSearchWhite(pContext, move, depth, sideToMove, alpha, beta);
+	return ChessKernelSearchBlack(pContext, move, depth, sideToMove, alpha, beta);
+}
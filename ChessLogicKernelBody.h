@@ -0,0 +1,285 @@
+/* The body of the minimax search, included once for every binding of its callbacks: by ChessLogicKernel.c once
+   for every root color with direct calls, and by GenericMinimaxAlgorithm.c with the callbacks and the color the
+   generic ChessMinimax keeps in the SEARCH_CONTEXT. There is no include guard on purpose. The includer defines:
+   KERNEL_COLOR				the color the scores are seen from, the maximum
+   KERNEL_FUNCTION(name)		the names of the functions of this binding
+   KERNEL_GET_ALL_MOVES(pPosition, color, pMoves)		fills the buffer with the legal moves of color, returns their number
+   KERNEL_GET_CAPTURES(pPosition, color, pMoves)		the same for the captures and promotions
+   KERNEL_MAKE_MOVE(pPosition, move, pUndo), KERNEL_UNMAKE_MOVE(pPosition, pUndo)
+   KERNEL_BOARD_SCORE(pPosition)						the static score from the view of KERNEL_COLOR
+   Every function of the body takes the context as pContext, the bindings may read it */
+
+#define KERNEL_MATED_SCORE(sideToMove)	(((sideToMove) == KERNEL_COLOR) ? -50000 : 50000) // the score when sideToMove is mated
+
+/* PRIVATE METHODS DECLARATIONS */
+static int KERNEL_FUNCTION(ChessKernelSearch)(SEARCH_CONTEXT*, CHESS_MOVE, int, PLAYER_COLOR, int, int); // plays the move and scores the node after it
+static int KERNEL_FUNCTION(ChessKernelSearchMove)(SEARCH_CONTEXT*, CHESS_MOVE, int, PLAYER_COLOR, int, int, int, int); // scouts, reduces and searches again a move of a node
+static int KERNEL_FUNCTION(ChessKernelQuiescence)(SEARCH_CONTEXT*, PLAYER_COLOR, int, int, int); // plays out the captures of a leaf
+
+/* PRIVATE METHODS IMPLEMENTATIONS */
+
+/* move is played, then sideToMove searches depth - 1 plies more and the captures after them. MOVE_NONE passes the
+   turn, for the null move. Scores are seen from KERNEL_COLOR, the maximum, in the closed window [alpha, beta]:
+   a node is cut when beta < alpha, and a score on an edge of the window is exact */
+static int KERNEL_FUNCTION(ChessKernelSearch)(SEARCH_CONTEXT* pContext, CHESS_MOVE move, int depth, PLAYER_COLOR sideToMove, int alpha, int beta) {
+	CHESS_POSITION* pPosition = &pContext->position; // this thread's copy
+	PLAYER_COLOR oppositeColor = OPPOSITE_COLOR(sideToMove);
+	int isMax = (sideToMove == KERNEL_COLOR);
+	int sign = isMax ? 1 : -1; // the table keeps scores of the side to move, this search keeps those of KERNEL_COLOR
+	int bestScore, score, i, bestIndex = 0;
+	int originalAlpha = alpha, originalBeta = beta;
+	int inCheck = 0, extended = 0, staticScore = 0, futility = 0, futilityScore = 0;
+	MOVE_UNDO undo; // the move is taken back before returning
+	MOVE_BUFFER moves; // this ply's moves, on the stack
+	int keys[MAX_MOVES_PER_POSITION]; // their order
+	ZOBRIST_KEY key;
+	TT_ENTRY entry;
+	int found, canMove;
+
+	if (ChessLogicSearchNode(pContext))
+		return 0; // out of budget, the caller drops what this search returns
+
+	if (move != MOVE_NONE)
+		KERNEL_MAKE_MOVE(pPosition, move, &undo);
+
+	// check extension: a side under check is searched a ply deeper, so a leaf never ends in the middle of a forcing line.
+	// It is a part of the depth of this node, the table keeps it under the deeper depth. Checks answered by checks
+	// could extend forever, the ply limit ends them
+	if (pContext->features & (SEARCH_FEATURE_CHECK_EXTENSION | SEARCH_FEATURE_NULL_MOVE | SEARCH_FEATURE_LMR | SEARCH_FEATURE_FUTILITY | SEARCH_FEATURE_RAZORING))
+		inCheck = ChessLogicIsCheck(pPosition, sideToMove);
+	if ((pContext->features & SEARCH_FEATURE_CHECK_EXTENSION) && inCheck && pContext->ply < MAX_SEARCH_PLY)
+		depth++;
+
+	// a node searched as deep before ends here, when its stored score decides this window. A deeper score is taken
+	// too, except with several threads: which of them stored a deeper entry first depends on timing, and the root
+	// scores must not, so there only the same depth is taken.
+	// The window is closed, a score on its edge counts as exact, so a bound decides only from strictly outside it
+	key = POSITION_KEY(pPosition, sideToMove);
+	found = ChessLogicTTProbe(key, &entry);
+	if (found && (pContext->exactDepth ? (entry.depth == depth - 1) : (entry.depth >= depth - 1))) {
+		score = sign * entry.score;
+		if (entry.bound == TT_BOUND_EXACT
+			|| (entry.bound == (isMax ? TT_BOUND_LOWER : TT_BOUND_UPPER) && score > beta)
+			|| (entry.bound == (isMax ? TT_BOUND_UPPER : TT_BOUND_LOWER) && score < alpha)) {
+			if (move != MOVE_NONE)
+				KERNEL_UNMAKE_MOVE(pPosition, &undo);
+			return score;
+		}
+	}
+
+	// a side that cant move is mated under check, and tied otherwise. A leaf only asks whether it has a move,
+	// a node generates its moves once and asks their count
+	if (depth == 1)
+		canMove = ChessLogicHasLegalMove(pPosition, sideToMove);
+	else
+		canMove = KERNEL_GET_ALL_MOVES(pPosition, sideToMove, &moves) > 0;
+	if (!canMove) {
+		score = ChessLogicIsCheck(pPosition, sideToMove) ? KERNEL_MATED_SCORE(sideToMove) : 0;
+		ChessLogicTTStore(key, depth - 1, sign * score, TT_BOUND_EXACT, MOVE_NONE);
+		if (move != MOVE_NONE)
+			KERNEL_UNMAKE_MOVE(pPosition, &undo);
+		return score;
+	}
+
+	// the horizon: a leaf isnt scored in the middle of an exchange, its captures are played out first
+	if (depth == 1) {
+		score = KERNEL_BOARD_SCORE(pPosition);
+		score = KERNEL_FUNCTION(ChessKernelQuiescence)(pContext, sideToMove, alpha, beta, score);
+		if (!ChessLogicSearchStopped())
+			ChessLogicTTStore(key, 0, sign * score, ChessLogicSearchBound(score, alpha, beta, sign), MOVE_NONE);
+		if (move != MOVE_NONE)
+			KERNEL_UNMAKE_MOVE(pPosition, &undo);
+		return score;
+	}
+
+	// single reply: the only move of a node is searched a ply deeper. A node has a single move mostly under check, there
+	// the ply comes on top of the check extension: a check with one answer is the most forcing line there is
+	if ((pContext->features & SEARCH_FEATURE_SINGLE_REPLY) && moves.count == 1 && pContext->ply < MAX_SEARCH_PLY)
+		extended = 1;
+
+	if (!inCheck && (pContext->features & (SEARCH_FEATURE_NULL_MOVE | SEARCH_FEATURE_FUTILITY | SEARCH_FEATURE_RAZORING)))
+		staticScore = KERNEL_BOARD_SCORE(pPosition);
+
+	// razoring: a node close to the horizon whose static score is far behind the window only plays out its captures.
+	// When they dont bring it back to the window either, no quiet move is expected to
+	if ((pContext->features & SEARCH_FEATURE_RAZORING) && !inCheck && depth - 1 <= RAZOR_DEPTH
+		&& (isMax ? (staticScore + RAZOR_MARGIN < alpha) : (staticScore - RAZOR_MARGIN > beta))) {
+		score = isMax ? alpha : beta;
+		score = KERNEL_FUNCTION(ChessKernelQuiescence)(pContext, sideToMove, score, score, staticScore);
+		if (!ChessLogicSearchStopped() && (isMax ? (score < alpha) : (score > beta))) {
+			if (move != MOVE_NONE)
+				KERNEL_UNMAKE_MOVE(pPosition, &undo);
+			return score;
+		}
+	}
+
+	// null move: a side that is still past the window after passing the turn, searched shallower, would be past
+	// it after any real move too. Not under check, not right after another null move, and not with only pawns
+	// left, where passing would be the best move (zugzwang) and the test lies
+	if ((pContext->features & SEARCH_FEATURE_NULL_MOVE) && move != MOVE_NONE && !inCheck && depth - 1 - NULL_MOVE_REDUCTION >= 1
+		&& (pPosition->occupancy[sideToMove] & ~pPosition->pieces[PIECE_OF_COLOR(WHITE_PAWN, sideToMove)] & ~pPosition->pieces[PIECE_OF_COLOR(WHITE_KING, sideToMove)])
+		&& (isMax ? (staticScore > beta) : (staticScore < alpha))) {
+		pContext->ply++;
+		score = KERNEL_FUNCTION(ChessKernelSearch)(pContext, MOVE_NONE, depth - 1 - NULL_MOVE_REDUCTION, oppositeColor, isMax ? beta : alpha, isMax ? beta : alpha);
+		pContext->ply--;
+		if (!ChessLogicSearchStopped() && (isMax ? (score > beta) : (score < alpha))) {
+			// a mate found after passing isnt a mate of this node, only a bound past the window
+			if (score == 50000 || score == -50000)
+				score = isMax ? beta + 1 : alpha - 1;
+			KERNEL_UNMAKE_MOVE(pPosition, &undo);
+			return score;
+		}
+	}
+
+	// the best move stored for this node is searched first, then the moves likely to cut
+	ChessLogicOrderMoves(pContext, &moves, found ? entry.bestMove : MOVE_NONE, keys);
+
+	// futility pruning: close to the horizon, a quiet move is skipped when even a gain of the margin wouldnt bring the
+	// static score to the window. The first move is always searched. The node may have missed futilityScore, so it
+	// returns a bound no tighter than that
+	if ((pContext->features & SEARCH_FEATURE_FUTILITY) && !inCheck && depth - 1 <= FUTILITY_DEPTH) {
+		futility = 1;
+		futilityScore = isMax ? staticScore + FUTILITY_MARGIN * (depth - 1) : staticScore - FUTILITY_MARGIN * (depth - 1);
+	}
+
+	bestScore = isMax ? -50000 : 50000;
+	for (i = 0; i < moves.count; i++) {
+		ChessLogicPickMove(&moves, keys, i);
+		if (futility && i > 0 && MOVE_IS_QUIET(moves.moves[i]) && (isMax ? (futilityScore < alpha) : (futilityScore > beta))) {
+			if (isMax ? (futilityScore > bestScore) : (futilityScore < bestScore))
+				bestScore = futilityScore;
+			continue;
+		}
+		pContext->ply++;
+		score = KERNEL_FUNCTION(ChessKernelSearchMove)(pContext, moves.moves[i], depth - 1 + extended, oppositeColor, alpha, beta, i,
+			ChessLogicSearchReduction(pContext, moves.moves[i], i, depth - 1 + extended, inCheck));
+		pContext->ply--;
+		if (isMax) {
+			if (score > bestScore) {
+				bestScore = score;
+				bestIndex = i;
+			}
+			if (bestScore > alpha)
+				alpha = bestScore;
+		}
+		else {
+			if (score < bestScore) {
+				bestScore = score;
+				bestIndex = i;
+			}
+			if (bestScore < beta)
+				beta = bestScore;
+		}
+		if (beta < alpha) {
+			ChessLogicSearchCutoff(pContext, moves.moves[i], depth - 1, i);
+			break;
+		}
+		if (ChessLogicSearchStopped())
+			break;
+	}
+	if (ChessLogicSearchStopped()) {
+		if (move != MOVE_NONE)
+			KERNEL_UNMAKE_MOVE(pPosition, &undo);
+		return 0; // some moves werent searched, the score means nothing
+	}
+
+	// a score outside the window is only a bound
+	ChessLogicTTStore(key, depth - 1, sign * bestScore, ChessLogicSearchBound(bestScore, originalAlpha, originalBeta, sign), moves.moves[bestIndex]);
+	if (move != MOVE_NONE)
+		KERNEL_UNMAKE_MOVE(pPosition, &undo);
+	return bestScore;
+}
+
+/* The node of the move (played by the opposite of sideToMove) is a maximum when sideToMove isnt KERNEL_COLOR, and
+   must beat alpha, or a minimum that must get below beta. The first move (index 0) gets the full window. With PVS
+   the others are scouted with a null window on that bound, and a reduced move is always scouted at its reduced
+   depth. A move that beats the bound is searched again: at its full depth, then with the full window */
+static int KERNEL_FUNCTION(ChessKernelSearchMove)(SEARCH_CONTEXT* pContext, CHESS_MOVE move, int depth, PLAYER_COLOR sideToMove, int alpha, int beta, int index, int reduction) {
+	int isMax = (sideToMove != KERNEL_COLOR);
+	int bound = isMax ? alpha : beta;
+	int score;
+
+	if (index == 0 || (reduction == 0 && !(pContext->features & SEARCH_FEATURE_PVS)))
+		return KERNEL_FUNCTION(ChessKernelSearch)(pContext, move, depth, sideToMove, alpha, beta);
+	score = KERNEL_FUNCTION(ChessKernelSearch)(pContext, move, depth - reduction, sideToMove, bound, bound);
+	if (reduction > 0 && (pContext->features & SEARCH_FEATURE_PVS) && (isMax ? score > bound : score < bound) && !ChessLogicSearchStopped())
+		score = KERNEL_FUNCTION(ChessKernelSearch)(pContext, move, depth, sideToMove, bound, bound);
+	if ((isMax ? (score > bound && score <= beta) : (score < bound && score >= alpha)) && !ChessLogicSearchStopped())
+		score = KERNEL_FUNCTION(ChessKernelSearch)(pContext, move, depth, sideToMove, alpha, beta);
+	return score;
+}
+
+/* Quiescence search: sideToMove may stand pat on the static score (standPat) or play one of its captures and
+   promotions, and so on until no capture is worth playing. Scores are seen from KERNEL_COLOR.
+   Delta pruning skips a capture that cant bring the score back into the window even if it went unanswered.
+   Only a mate is told apart from the static score: a side under check that has no move. A tie isnt looked for */
+static int KERNEL_FUNCTION(ChessKernelQuiescence)(SEARCH_CONTEXT* pContext, PLAYER_COLOR sideToMove, int alpha, int beta, int standPat) {
+	CHESS_POSITION* pPosition = &pContext->position;
+	PLAYER_COLOR oppositeColor = OPPOSITE_COLOR(sideToMove);
+	int isMax = (sideToMove == KERNEL_COLOR);
+	MOVE_BUFFER captures;
+	int keys[MAX_MOVES_PER_POSITION];
+	MOVE_UNDO undo;
+	int i, gain, score, bestScore = standPat;
+
+	if (ChessLogicIsCheck(pPosition, sideToMove) && !ChessLogicHasLegalMove(pPosition, sideToMove))
+		return KERNEL_MATED_SCORE(sideToMove);
+	if (isMax) {
+		if (bestScore > beta)
+			return bestScore;
+		if (bestScore > alpha)
+			alpha = bestScore;
+	}
+	else {
+		if (bestScore < alpha)
+			return bestScore;
+		if (bestScore < beta)
+			beta = bestScore;
+	}
+
+	KERNEL_GET_CAPTURES(pPosition, sideToMove, &captures);
+	ChessLogicOrderCaptures(pPosition, &captures, keys);
+	for (i = 0; i < captures.count; i++) {
+		ChessLogicPickMove(&captures, keys, i);
+		gain = ChessLogicMoveGain(pPosition, captures.moves[i]) + QUIESCENCE_DELTA_MARGIN;
+		// a skipped capture could still have reached standPat +- gain: the bound returned stays that loose, so the
+		// table never keeps it as a tighter bound than the search proved
+		if (isMax && standPat + gain < alpha) {
+			if (standPat + gain > bestScore)
+				bestScore = standPat + gain;
+			continue;
+		}
+		if (!isMax && standPat - gain > beta) {
+			if (standPat - gain < bestScore)
+				bestScore = standPat - gain;
+			continue;
+		}
+		if (ChessLogicSearchNode(pContext))
+			return 0;
+
+		KERNEL_MAKE_MOVE(pPosition, captures.moves[i], &undo);
+		score = KERNEL_BOARD_SCORE(pPosition);
+		score = KERNEL_FUNCTION(ChessKernelQuiescence)(pContext, oppositeColor, alpha, beta, score);
+		KERNEL_UNMAKE_MOVE(pPosition, &undo);
+		if (ChessLogicSearchStopped())
+			return 0;
+
+		if (isMax) {
+			if (score > bestScore)
+				bestScore = score;
+			if (bestScore > alpha)
+				alpha = bestScore;
+		}
+		else {
+			if (score < bestScore)
+				bestScore = score;
+			if (bestScore < beta)
+				beta = bestScore;
+		}
+		if (beta < alpha)
+			break;
+	}
+	return bestScore;
+}
+
+#undef KERNEL_MATED_SCORE
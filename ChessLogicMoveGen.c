@@ -0,0 +1,355 @@
+#include "ChessCommonDefs.h"
+#include "CommonUtils.h"
+#include "ChessCommonUtils.h"
+#include "ChessLogicProtected.h"
+
+/* PRIVATE METHODS DECLARATIONS */
+
+void ChessLogicAddMove(MOVE_BUFFER*, int, int, int); // appends a move between two squares to the buffer
+void ChessLogicAddPawnMove(MOVE_BUFFER*, int, int, int, PLAYER_COLOR); // appends a pawn move, or all its promotions
+void ChessLogicAddPieceMoves(MOVE_BUFFER*, CHESS_PIECE_TYPE, int, BITBOARD, BITBOARD, PLAYER_COLOR); // appends a move to every square of the target set, flagging the victims
+BITBOARD ChessLogicPieceTargets(CHESS_POSITION*, CHESS_PIECE_TYPE, int, PLAYER_COLOR); // the squares one piece can move to, ignoring checks
+BITBOARD ChessLogicLegalTargets(const MOVE_LEGALITY*, CHESS_PIECE_TYPE, int); // the squares one piece may move to without exposing its king
+BITBOARD ChessLogicBetween(int, int, BITBOARD(*)(int, BITBOARD)); // the squares between two squares on a rook or bishop line
+
+/* PUBLIC METHODS IMPLEMENTATIONS */
+
+MOVE_STATUS ChessLogicGetMovesPiece(CHESS_POSITION* pPosition, BOARD_LOCATION place, MOVE_BUFFER* pMoves, PLAYER_COLOR color, int filter) {
+	int x = place.column;
+	int y = place.row;
+	int square = SQUARE(x, y);
+	MOVE_LEGALITY legality;
+	CHESS_PIECE_TYPE type;
+	BITBOARD targets;
+
+	// checks if start and end of moves are valid positiona on the board
+	if (!ChessLogicValidPlace(x, y)) {
+		DEBUG_PRINT("returning INVALID_BOARD_POSITION");
+		return INVALID_BOARD_POSITION; // message 1
+	}
+	// checks if the position contains the correct color
+	if (color == PLAYER_COLOR_BLANK || !(pPosition->occupancy[color] & SQUARE_BIT(square))) {
+		DEBUG_PRINT("returning INVALID_PIECE");
+		return INVALID_PIECE; // message 2
+	}
+	type = POSITION_PIECE_AT(pPosition, square);
+	targets = ChessLogicPieceTargets(pPosition, type, square, color);
+
+	// keep only the moves that dont result in check (or leave the player under check)
+	if (filter) {
+		ChessLogicGetLegality(pPosition, color, &legality);
+		targets &= ChessLogicLegalTargets(&legality, type, square);
+	}
+	ChessLogicAddPieceMoves(pMoves, type, square, targets, pPosition->occupancy[OPPOSITE_COLOR(color)], color);
+
+	return MOVE_SUCCESSFUL;  // there may be no possible moves , but is everything is ok
+}
+
+//filter is for filtering non-check moves or not. returns the number of moves written to pMoves
+int ChessInternalGetAllMoves(CHESS_POSITION* pPosition, PLAYER_COLOR color, int filter, MOVE_BUFFER* pMoves) {
+	MOVE_LEGALITY legality;
+	BITBOARD pieces = pPosition->occupancy[color];
+	BITBOARD targets;
+	CHESS_PIECE_TYPE type;
+	int square;
+	MOVE_BUFFER_RESET(pMoves);
+	if (filter)
+		ChessLogicGetLegality(pPosition, color, &legality); // once for all the pieces
+	//calculate all possible moves, in the column by column order of the board
+	while (pieces) {
+		BITBOARD_POP_LSB(pieces, square);
+		type = POSITION_PIECE_AT(pPosition, square);
+		targets = ChessLogicPieceTargets(pPosition, type, square, color);
+		if (filter)
+			targets &= ChessLogicLegalTargets(&legality, type, square);
+		ChessLogicAddPieceMoves(pMoves, type, square, targets, pPosition->occupancy[OPPOSITE_COLOR(color)], color);
+	}
+	return pMoves->count;
+}
+
+// the legal moves of color that eat a piece or promote a pawn, all a quiescence search plays. returns their number
+int ChessInternalGetCaptures(CHESS_POSITION* pPosition, PLAYER_COLOR color, MOVE_BUFFER* pMoves) {
+	MOVE_LEGALITY legality;
+	BITBOARD pieces = pPosition->occupancy[color];
+	BITBOARD victims = pPosition->occupancy[OPPOSITE_COLOR(color)];
+	BITBOARD promotionRow = (color == PLAYER_COLOR_WHITE) ? BITBOARD_ROW_8 : BITBOARD_ROW_1;
+	BITBOARD targets;
+	CHESS_PIECE_TYPE type;
+	int square;
+	MOVE_BUFFER_RESET(pMoves);
+	ChessLogicGetLegality(pPosition, color, &legality);
+	while (pieces) {
+		BITBOARD_POP_LSB(pieces, square);
+		type = POSITION_PIECE_AT(pPosition, square);
+		targets = victims;
+		if (type == WHITE_PAWN || type == BLACK_PAWN)
+			targets |= promotionRow;
+		targets &= ChessLogicPieceTargets(pPosition, type, square, color) & ChessLogicLegalTargets(&legality, type, square);
+		ChessLogicAddPieceMoves(pMoves, type, square, targets, pPosition->occupancy[OPPOSITE_COLOR(color)], color);
+	}
+	return pMoves->count;
+}
+
+// like ChessInternalGetAllMoves with filter, but stops at the first legal move and never writes a move
+int ChessLogicHasLegalMove(CHESS_POSITION* pPosition, PLAYER_COLOR color) {
+	MOVE_LEGALITY legality;
+	BITBOARD pieces = pPosition->occupancy[color];
+	CHESS_PIECE_TYPE king = PIECE_OF_COLOR(WHITE_KING, color);
+	int square;
+	ChessLogicGetLegality(pPosition, color, &legality);
+	// the king first: under a double check it is the only piece that may move
+	if (legality.kingSquare != -1 && (ChessLogicPieceTargets(pPosition, king, legality.kingSquare, color) & ~legality.attacked))
+		return 1;
+	if (legality.evasions == BITBOARD_EMPTY)
+		return 0;
+	pieces &= ~pPosition->pieces[king];
+	while (pieces) {
+		BITBOARD_POP_LSB(pieces, square);
+		if (ChessLogicPieceTargets(pPosition, POSITION_PIECE_AT(pPosition, square), square, color) & ChessLogicLegalTargets(&legality, POSITION_PIECE_AT(pPosition, square), square))
+			return 1;
+	}
+	return 0;
+}
+
+/* Perft: counts the leaves of the legal move tree, depth plies deep. The moves of the last ply are counted, not made */
+unsigned long long ChessInternalPerft(CHESS_POSITION* pPosition, PLAYER_COLOR color, int depth) {
+	MOVE_BUFFER moves;
+	MOVE_UNDO undo;
+	unsigned long long nodes = 0;
+	int i;
+	if (depth <= 0)
+		return 1;
+	ChessInternalGetAllMoves(pPosition, color, 1, &moves);
+	if (depth == 1)
+		return moves.count;
+	for (i = 0; i < moves.count; i++) {
+		ChessLogicMakeMove(pPosition, moves.moves[i], &undo);
+		nodes += ChessInternalPerft(pPosition, OPPOSITE_COLOR(color), depth - 1);
+		ChessLogicUnmakeMove(pPosition, &undo);
+	}
+	return nodes;
+}
+
+// perft split by root move: every root move is reported with the leaves below it, returns the total
+unsigned long long ChessInternalPerftDivide(CHESS_POSITION* pPosition, PLAYER_COLOR color, int depth, void(*ReportMove)(GAME_MOVE, unsigned long long)) {
+	MOVE_BUFFER moves;
+	MOVE_UNDO undo;
+	unsigned long long nodes, total = 0;
+	int i;
+	if (depth <= 0)
+		return 1;
+	ChessInternalGetAllMoves(pPosition, color, 1, &moves);
+	for (i = 0; i < moves.count; i++) {
+		ChessLogicMakeMove(pPosition, moves.moves[i], &undo);
+		nodes = ChessInternalPerft(pPosition, OPPOSITE_COLOR(color), depth - 1);
+		ChessLogicUnmakeMove(pPosition, &undo);
+		ReportMove(ChessLogicUnpackMove(moves.moves[i]), nodes);
+		total += nodes;
+	}
+	return total;
+}
+
+/* A move of color is legal when it doesnt leave its king attacked. With no castling and no en passant that means:
+   the king steps only to squares the opposite color doesnt attack, under a double check only the king moves,
+   under a single check the other pieces must capture the checker or block its ray, and a pinned piece stays on its pin ray */
+void ChessLogicGetLegality(CHESS_POSITION* pPosition, PLAYER_COLOR color, MOVE_LEGALITY* pLegality) {
+	const BITBOARD* pieces = pPosition->pieces;
+	PLAYER_COLOR oppositeColor = OPPOSITE_COLOR(color);
+	BITBOARD king = pieces[PIECE_OF_COLOR(WHITE_KING, color)];
+	BITBOARD occupied = POSITION_OCCUPIED(pPosition);
+	BITBOARD oppPawns = pieces[PIECE_OF_COLOR(WHITE_PAWN, oppositeColor)];
+	BITBOARD oppKnights = pieces[PIECE_OF_COLOR(WHITE_KNIGHT, oppositeColor)];
+	BITBOARD oppQueens = pieces[PIECE_OF_COLOR(WHITE_QUEEN, oppositeColor)];
+	BITBOARD oppRooks = pieces[PIECE_OF_COLOR(WHITE_ROOK, oppositeColor)] | oppQueens; // everything that slides like a rook
+	BITBOARD oppBishops = pieces[PIECE_OF_COLOR(WHITE_BISHOP, oppositeColor)] | oppQueens; // everything that slides like a bishop
+	BITBOARD rookCheckers, bishopCheckers, snipers, between, blockers, sliders;
+	int square;
+
+	pLegality->attacked = ChessLogicAttackMap(pPosition, oppositeColor);
+	pLegality->checkers = BITBOARD_EMPTY;
+	pLegality->evasions = ~BITBOARD_EMPTY;
+	pLegality->pinned = BITBOARD_EMPTY;
+	pLegality->kingSquare = -1;
+	if (king == BITBOARD_EMPTY)
+		return;
+	pLegality->kingSquare = BITBOARD_LSB(king);
+
+	// checks
+	rookCheckers = ROOK_ATTACKS(pLegality->kingSquare, occupied) & oppRooks;
+	bishopCheckers = BISHOP_ATTACKS(pLegality->kingSquare, occupied) & oppBishops;
+	pLegality->checkers = (pawnAttacks[color][pLegality->kingSquare] & oppPawns) | (knightAttacks[pLegality->kingSquare] & oppKnights) | rookCheckers | bishopCheckers;
+	if (pLegality->checkers) {
+		if (BITBOARD_POPCOUNT(pLegality->checkers) > 1)
+			pLegality->evasions = BITBOARD_EMPTY;
+		else if (rookCheckers)
+			pLegality->evasions = rookCheckers | ChessLogicBetween(pLegality->kingSquare, BITBOARD_LSB(rookCheckers), ChessLogicRookAttacksFrom);
+		else if (bishopCheckers)
+			pLegality->evasions = bishopCheckers | ChessLogicBetween(pLegality->kingSquare, BITBOARD_LSB(bishopCheckers), ChessLogicBishopAttacksFrom);
+		else
+			pLegality->evasions = pLegality->checkers;
+		// the king cant step back along the ray of a slider that checks it either: the map stops the ray at the king
+		sliders = rookCheckers;
+		while (sliders) {
+			BITBOARD_POP_LSB(sliders, square);
+			pLegality->attacked |= ROOK_ATTACKS(square, occupied & ~king);
+		}
+		sliders = bishopCheckers;
+		while (sliders) {
+			BITBOARD_POP_LSB(sliders, square);
+			pLegality->attacked |= BISHOP_ATTACKS(square, occupied & ~king);
+		}
+	}
+
+	// pins: sliders that would see the king if a single own piece was not in the way
+	snipers = ROOK_ATTACKS(pLegality->kingSquare, pPosition->occupancy[oppositeColor]) & oppRooks;
+	while (snipers) {
+		BITBOARD_POP_LSB(snipers, square);
+		between = ChessLogicBetween(pLegality->kingSquare, square, ChessLogicRookAttacksFrom);
+		blockers = between & occupied;
+		if (blockers && !(blockers & (blockers - 1))) {
+			pLegality->pinned |= blockers;
+			pLegality->pinRays[BITBOARD_LSB(blockers)] = between | SQUARE_BIT(square);
+		}
+	}
+	snipers = BISHOP_ATTACKS(pLegality->kingSquare, pPosition->occupancy[oppositeColor]) & oppBishops;
+	while (snipers) {
+		BITBOARD_POP_LSB(snipers, square);
+		between = ChessLogicBetween(pLegality->kingSquare, square, ChessLogicBishopAttacksFrom);
+		blockers = between & occupied;
+		if (blockers && !(blockers & (blockers - 1))) {
+			pLegality->pinned |= blockers;
+			pLegality->pinRays[BITBOARD_LSB(blockers)] = between | SQUARE_BIT(square);
+		}
+	}
+}
+
+//returns true if player color is under check
+int ChessLogicIsCheck(CHESS_POSITION* pPosition, PLAYER_COLOR color) {
+	BITBOARD king = pPosition->pieces[PIECE_OF_COLOR(WHITE_KING, color)];
+	if (king == BITBOARD_EMPTY)
+		return 0;
+	return ChessLogicIsSquareAttacked(pPosition, BITBOARD_LSB(king), OPPOSITE_COLOR(color));
+}
+
+/* A cached map answers with one bit. Otherwise the square looks out as every kind of piece, and meets a piece
+   of color of that kind: cheaper than a whole map when only one square is asked about */
+int ChessLogicIsSquareAttacked(const CHESS_POSITION* pPosition, int square, PLAYER_COLOR color) {
+	const BITBOARD* pieces = pPosition->pieces;
+	BITBOARD occupied = POSITION_OCCUPIED(pPosition);
+	BITBOARD queens = pieces[PIECE_OF_COLOR(WHITE_QUEEN, color)];
+
+	if (pPosition->attackMapsValid & (1 << color))
+		return (pPosition->attackMaps[color] & SQUARE_BIT(square)) != BITBOARD_EMPTY;
+	if ((pawnAttacks[OPPOSITE_COLOR(color)][square] & pieces[PIECE_OF_COLOR(WHITE_PAWN, color)])
+		|| (knightAttacks[square] & pieces[PIECE_OF_COLOR(WHITE_KNIGHT, color)])
+		|| (kingAttacks[square] & pieces[PIECE_OF_COLOR(WHITE_KING, color)])
+		|| (ROOK_ATTACKS(square, occupied) & (pieces[PIECE_OF_COLOR(WHITE_ROOK, color)] | queens))
+		|| (BISHOP_ATTACKS(square, occupied) & (pieces[PIECE_OF_COLOR(WHITE_BISHOP, color)] | queens)))
+		return 1;
+	return 0;
+}
+
+/* every square a piece of color attacks, whether empty, held by the other color (a capture) or by color (defended) */
+BITBOARD ChessLogicAttackMap(CHESS_POSITION* pPosition, PLAYER_COLOR color) {
+	const BITBOARD* pieces = pPosition->pieces;
+	BITBOARD occupied = POSITION_OCCUPIED(pPosition);
+	BITBOARD queens = pieces[PIECE_OF_COLOR(WHITE_QUEEN, color)];
+	BITBOARD sliders, attacks;
+	int square;
+
+	if (pPosition->attackMapsValid & (1 << color))
+		return pPosition->attackMaps[color];
+	attacks = ChessLogicPawnAttacks(pieces[PIECE_OF_COLOR(WHITE_PAWN, color)], color) | ChessLogicKnightAttacks(pieces[PIECE_OF_COLOR(WHITE_KNIGHT, color)])
+		| ChessLogicKingAttacks(pieces[PIECE_OF_COLOR(WHITE_KING, color)]);
+	sliders = pieces[PIECE_OF_COLOR(WHITE_ROOK, color)] | queens;
+	while (sliders) {
+		BITBOARD_POP_LSB(sliders, square);
+		attacks |= ROOK_ATTACKS(square, occupied);
+	}
+	sliders = pieces[PIECE_OF_COLOR(WHITE_BISHOP, color)] | queens;
+	while (sliders) {
+		BITBOARD_POP_LSB(sliders, square);
+		attacks |= BISHOP_ATTACKS(square, occupied);
+	}
+	pPosition->attackMaps[color] = attacks;
+	pPosition->attackMapsValid |= 1 << color;
+	return attacks;
+}
+
+/* PRIVATE METHODS IMPLEMENTATIONS */
+
+void ChessLogicAddMove(MOVE_BUFFER* pMoves, int origin, int destination, int flags) {
+	assert(pMoves->count < MAX_MOVES_PER_POSITION);
+	pMoves->moves[pMoves->count++] = MOVE_ENCODE(origin, destination, flags);
+}
+
+void ChessLogicAddPawnMove(MOVE_BUFFER* pMoves, int origin, int destination, int flags, PLAYER_COLOR color) {
+	if (SQUARE_ROW(destination) == ((color == PLAYER_COLOR_WHITE) ? BOARD_SIZE - 1 : 0)) { // promotion
+		ChessLogicAddMove(pMoves, origin, destination, flags | MOVE_PROMOTION_FLAGS(WHITE_QUEEN));
+		ChessLogicAddMove(pMoves, origin, destination, flags | MOVE_PROMOTION_FLAGS(WHITE_BISHOP));
+		ChessLogicAddMove(pMoves, origin, destination, flags | MOVE_PROMOTION_FLAGS(WHITE_KNIGHT));
+		ChessLogicAddMove(pMoves, origin, destination, flags | MOVE_PROMOTION_FLAGS(WHITE_ROOK));
+	}
+	else
+		ChessLogicAddMove(pMoves, origin, destination, flags);
+}
+
+void ChessLogicAddPieceMoves(MOVE_BUFFER* pMoves, CHESS_PIECE_TYPE type, int origin, BITBOARD targets, BITBOARD victims, PLAYER_COLOR color) {
+	int destination, flags;
+	while (targets) {
+		BITBOARD_POP_LSB(targets, destination);
+		flags = (victims & SQUARE_BIT(destination)) ? MOVE_FLAG_CAPTURE : 0;
+		if (type == WHITE_PAWN || type == BLACK_PAWN)
+			ChessLogicAddPawnMove(pMoves, origin, destination, flags, color);
+		else
+			ChessLogicAddMove(pMoves, origin, destination, flags);
+	}
+}
+
+BITBOARD ChessLogicPieceTargets(CHESS_POSITION* pPosition, CHESS_PIECE_TYPE type, int square, PLAYER_COLOR color) {
+	BITBOARD piece = SQUARE_BIT(square);
+	BITBOARD occupied = POSITION_OCCUPIED(pPosition);
+	BITBOARD targets = BITBOARD_EMPTY;
+	switch (type) {
+	case WHITE_PAWN: // one step forward, or one step diagonal right or left to eat
+		return (((piece << 1) & ~BITBOARD_ROW_1) & ~occupied) | (pawnAttacks[PLAYER_COLOR_WHITE][square] & pPosition->occupancy[PLAYER_COLOR_BLACK]);
+	case BLACK_PAWN: // one step backward (forward), or diagonal to eat
+		return (((piece >> 1) & ~BITBOARD_ROW_8) & ~occupied) | (pawnAttacks[PLAYER_COLOR_BLACK][square] & pPosition->occupancy[PLAYER_COLOR_WHITE]);
+	case WHITE_KNIGHT:
+	case BLACK_KNIGHT:
+		targets = knightAttacks[square];
+		break;
+	case WHITE_BISHOP:
+	case BLACK_BISHOP:
+		targets = BISHOP_ATTACKS(square, occupied);
+		break;
+	case WHITE_ROOK:
+	case BLACK_ROOK:
+		targets = ROOK_ATTACKS(square, occupied);
+		break;
+	case WHITE_QUEEN:
+	case BLACK_QUEEN:
+		targets = BISHOP_ATTACKS(square, occupied) | ROOK_ATTACKS(square, occupied);
+		break;
+	case WHITE_KING:
+	case BLACK_KING:
+		targets = kingAttacks[square];
+		break;
+	default:
+		break;
+	}
+	return targets & ~pPosition->occupancy[color];
+}
+
+BITBOARD ChessLogicLegalTargets(const MOVE_LEGALITY* pLegality, CHESS_PIECE_TYPE type, int square) {
+	if (type == WHITE_KING || type == BLACK_KING)
+		return ~pLegality->attacked;
+	if (pLegality->pinned & SQUARE_BIT(square))
+		return pLegality->evasions & pLegality->pinRays[square];
+	return pLegality->evasions;
+}
+
+/* the two squares must share a line of the given slider: each one's rays then meet exactly between them */
+BITBOARD ChessLogicBetween(int from, int to, BITBOARD(*SliderAttacks)(int, BITBOARD)) {
+	return SliderAttacks(from, SQUARE_BIT(to)) & SliderAttacks(to, SQUARE_BIT(from));
+}
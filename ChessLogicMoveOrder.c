@@ -0,0 +1,95 @@
+#include <string.h>
+
+#include "ChessCommonDefs.h"
+#include "CommonUtils.h"
+#include "ChessLogicProtected.h"
+
+/* Move ordering: alpha-beta cuts the most when the best move comes first. Every move gets a key and the search
+   picks them best key first: the move the transposition table remembers, then captures and promotions by most
+   valuable victim / least valuable attacker, then the two killers of the ply (quiet moves that cut a sibling
+   node), then the other quiet moves by their history (how often and how deep they cut before) */
+
+#define ORDER_HASH_MOVE		(1 << 30)
+#define ORDER_CAPTURE		(1 << 24)
+#define ORDER_KILLER		(1 << 22)
+#define ORDER_HISTORY_MAX	(ORDER_KILLER - 1)	// history values stay below the killers
+
+/* PRIVATE METHODS DECLARATIONS */
+int ChessLogicCaptureKey(CHESS_POSITION*, CHESS_MOVE); // most valuable victim, then least valuable attacker
+
+/* PUBLIC METHODS IMPLEMENTATIONS */
+
+void ChessLogicOrderMoves(SEARCH_CONTEXT* pContext, const MOVE_BUFFER* pMoves, CHESS_MOVE hashMove, int* keys) {
+	CHESS_POSITION* pPosition = &pContext->position;
+	CHESS_MOVE move;
+	CHESS_MOVE killers[2] = { MOVE_NONE, MOVE_NONE };
+	int i;
+	if (pContext->ply < MAX_SEARCH_PLY) {
+		killers[0] = pContext->killers[pContext->ply][0];
+		killers[1] = pContext->killers[pContext->ply][1];
+	}
+	for (i = 0; i < pMoves->count; i++) {
+		move = pMoves->moves[i];
+		if (move == hashMove)
+			keys[i] = ORDER_HASH_MOVE;
+		else if (!MOVE_IS_QUIET(move))
+			keys[i] = ORDER_CAPTURE + ChessLogicCaptureKey(pPosition, move);
+		else if (move == killers[0])
+			keys[i] = ORDER_KILLER + 1;
+		else if (move == killers[1])
+			keys[i] = ORDER_KILLER;
+		else
+			keys[i] = pContext->history[MOVE_ORIGIN(move)][MOVE_DESTINATION(move)];
+	}
+}
+
+void ChessLogicOrderCaptures(CHESS_POSITION* pPosition, const MOVE_BUFFER* pMoves, int* keys) {
+	int i;
+	for (i = 0; i < pMoves->count; i++)
+		keys[i] = ChessLogicCaptureKey(pPosition, pMoves->moves[i]);
+}
+
+// a selection step: when a node is cut after a few moves, the rest never had to be sorted
+void ChessLogicPickMove(MOVE_BUFFER* pMoves, int* keys, int index) {
+	CHESS_MOVE move;
+	int i, best = index, key;
+	for (i = index + 1; i < pMoves->count; i++)
+		if (keys[i] > keys[best])
+			best = i;
+	if (best == index)
+		return;
+	move = pMoves->moves[index];
+	pMoves->moves[index] = pMoves->moves[best];
+	pMoves->moves[best] = move;
+	key = keys[index];
+	keys[index] = keys[best];
+	keys[best] = key;
+}
+
+void ChessLogicOrderCutoff(SEARCH_CONTEXT* pContext, CHESS_MOVE move, int depth) {
+	CHESS_MOVE* killers;
+	int* pHistory;
+	int from, to;
+	if (!MOVE_IS_QUIET(move))
+		return; // captures are ordered well without it
+	if (pContext->ply < MAX_SEARCH_PLY) {
+		killers = pContext->killers[pContext->ply];
+		if (move != killers[0]) {
+			killers[1] = killers[0];
+			killers[0] = move;
+		}
+	}
+	pHistory = &pContext->history[MOVE_ORIGIN(move)][MOVE_DESTINATION(move)];
+	*pHistory += depth * depth;
+	if (*pHistory > ORDER_HISTORY_MAX) { // ages the whole table, the order of the moves stays
+		for (from = 0; from < NUM_OF_SQUARES; from++)
+			for (to = 0; to < NUM_OF_SQUARES; to++)
+				pContext->history[from][to] /= 2;
+	}
+}
+
+/* PRIVATE METHODS IMPLEMENTATIONS */
+
+int ChessLogicCaptureKey(CHESS_POSITION* pPosition, CHESS_MOVE move) {
+	return ChessLogicMoveGain(pPosition, move) * 1024 - ChessLogicPieceValue(POSITION_PIECE_AT(pPosition, MOVE_ORIGIN(move)));
+}
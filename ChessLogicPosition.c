@@ -0,0 +1,171 @@
+#include <stddef.h>
+
+#include "ChessCommonDefs.h"
+#include "ChessLogicProtected.h"
+
+/* GLOBAL DATA */
+ZOBRIST_KEY zobristPieces[NUM_OF_PIECE_TYPES][NUM_OF_SQUARES];
+ZOBRIST_KEY zobristBlackToMove;
+
+/* PRIVATE METHODS DECLARATIONS */
+
+void ChessLogicTogglePieces(CHESS_POSITION*, const MOVE_UNDO*); // flips the bitboards of a move, both ways
+void ChessLogicUpdateScores(CHESS_POSITION*, const MOVE_UNDO*, int); // adds the score changes of a move (1) or takes them back (-1)
+
+/* PUBLIC METHODS IMPLEMENTATIONS */
+
+void ChessLogicPositionFromBoard(BOARD board, CHESS_POSITION* pPosition) {
+	int square;
+	CHESS_PIECE_TYPE type;
+	BITBOARD* pieces = pPosition->pieces;
+	PLAYER_COLOR color;
+	ChessLogicInitZobrist();
+	ChessLogicInitEval();
+	ChessLogicInitAttacks();
+	for (type = PIECE_TYPE_MIN; type < NUM_OF_PIECE_TYPES; type++)
+		pieces[type] = BITBOARD_EMPTY;
+	pPosition->key = 0;
+	for (color = PLAYER_COLOR_WHITE; color < PLAYER_COLOR_NUM; color++) {
+		pPosition->midgame[color] = 0;
+		pPosition->endgame[color] = 0;
+	}
+	pPosition->phase = 0;
+	pPosition->attackMapsValid = 0;
+	for (square = 0; square < NUM_OF_SQUARES; square++) {
+		type = board[SQUARE_COLUMN(square)][SQUARE_ROW(square)];
+		POSITION_PIECE_AT(pPosition, square) = type;
+		if (type != BLANK_POSITION) {
+			pieces[type] |= SQUARE_BIT(square);
+			pPosition->key ^= zobristPieces[type][square];
+			pPosition->midgame[PIECE_COLOR(type)] += evalMidgame[type][square];
+			pPosition->endgame[PIECE_COLOR(type)] += evalEndgame[type][square];
+			pPosition->phase += evalPhase[type];
+		}
+	}
+	pPosition->occupancy[PLAYER_COLOR_WHITE] = pieces[WHITE_PAWN] | pieces[WHITE_BISHOP] | pieces[WHITE_KNIGHT] | pieces[WHITE_ROOK] | pieces[WHITE_QUEEN] | pieces[WHITE_KING];
+	pPosition->occupancy[PLAYER_COLOR_BLACK] = pieces[BLACK_PAWN] | pieces[BLACK_BISHOP] | pieces[BLACK_KNIGHT] | pieces[BLACK_ROOK] | pieces[BLACK_QUEEN] | pieces[BLACK_KING];
+}
+
+void ChessLogicPositionToBoard(const CHESS_POSITION* pPosition, BOARD board) {
+	int square;
+	for (square = 0; square < NUM_OF_SQUARES; square++)
+		board[SQUARE_COLUMN(square)][SQUARE_ROW(square)] = POSITION_PIECE_AT(pPosition, square);
+}
+
+/* same rules as performing a user move: a pawn that reaches the last row without a promotion piece becomes a queen */
+void ChessLogicMakeMove(CHESS_POSITION* pPosition, CHESS_MOVE move, MOVE_UNDO* pUndo) {
+	int origin = MOVE_ORIGIN(move);
+	int destination = MOVE_DESTINATION(move);
+	CHESS_PIECE_TYPE type = POSITION_PIECE_AT(pPosition, origin);
+	CHESS_PIECE_TYPE newType = type;
+
+	if (type == WHITE_PAWN && SQUARE_ROW(destination) == BOARD_SIZE - 1)
+		newType = MOVE_IS_PROMOTION(move) ? MOVE_PROMOTION_TYPE(move) : WHITE_QUEEN;
+	else if (type == BLACK_PAWN && SQUARE_ROW(destination) == 0)
+		newType = MOVE_IS_PROMOTION(move) ? MOVE_PROMOTION_TYPE(move) : BLACK_QUEEN;
+
+	pUndo->origin = origin;
+	pUndo->destination = destination;
+	pUndo->type = type;
+	pUndo->newType = newType;
+	pUndo->captured = POSITION_PIECE_AT(pPosition, destination);
+	pUndo->attackMaps[PLAYER_COLOR_WHITE] = pPosition->attackMaps[PLAYER_COLOR_WHITE];
+	pUndo->attackMaps[PLAYER_COLOR_BLACK] = pPosition->attackMaps[PLAYER_COLOR_BLACK];
+	pUndo->attackMapsValid = pPosition->attackMapsValid;
+	pPosition->attackMapsValid = 0;
+
+	ChessLogicTogglePieces(pPosition, pUndo);
+	ChessLogicUpdateScores(pPosition, pUndo, 1);
+	POSITION_PIECE_AT(pPosition, destination) = newType;
+	POSITION_PIECE_AT(pPosition, origin) = BLANK_POSITION;
+}
+
+void ChessLogicUnmakeMove(CHESS_POSITION* pPosition, const MOVE_UNDO* pUndo) {
+	ChessLogicTogglePieces(pPosition, pUndo);
+	ChessLogicUpdateScores(pPosition, pUndo, -1);
+	POSITION_PIECE_AT(pPosition, pUndo->origin) = pUndo->type;
+	POSITION_PIECE_AT(pPosition, pUndo->destination) = pUndo->captured;
+	pPosition->attackMaps[PLAYER_COLOR_WHITE] = pUndo->attackMaps[PLAYER_COLOR_WHITE];
+	pPosition->attackMaps[PLAYER_COLOR_BLACK] = pUndo->attackMaps[PLAYER_COLOR_BLACK];
+	pPosition->attackMapsValid = pUndo->attackMapsValid;
+}
+
+/* the keys come from a fixed xorshift sequence, so a position has the same key in every run */
+void ChessLogicInitZobrist() {
+	static int isInitialized = 0;
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+	int type, square;
+	if (isInitialized)
+		return;
+	for (type = PIECE_TYPE_MIN; type < NUM_OF_PIECE_TYPES; type++)
+		for (square = 0; square < NUM_OF_SQUARES; square++)
+			zobristPieces[type][square] = (type == BLANK_POSITION) ? 0 : ChessLogicNextRandom(&state);
+	zobristBlackToMove = ChessLogicNextRandom(&state);
+	isInitialized = 1;
+}
+
+uint64_t ChessLogicNextRandom(uint64_t* pState) {
+	*pState ^= *pState >> 12;
+	*pState ^= *pState << 25;
+	*pState ^= *pState >> 27;
+	return *pState * 0x2545F4914F6CDD1DULL;
+}
+
+CHESS_MOVE ChessLogicPackMove(const CHESS_POSITION* pPosition, GAME_MOVE move) {
+	int origin = SQUARE(move.origin.column, move.origin.row);
+	int destination = SQUARE(move.destination.column, move.destination.row);
+	int flags = 0;
+	if (move.newType != BLANK_POSITION) {
+		// the promotion bits only hold a bishop, knight, rook or queen, they take the color of the pawn
+		if (!((move.newType >= WHITE_BISHOP && move.newType <= WHITE_QUEEN) || (move.newType >= BLACK_BISHOP && move.newType <= BLACK_QUEEN))
+			|| PIECE_COLOR(move.newType) != PIECE_COLOR(POSITION_PIECE_AT(pPosition, origin)))
+			return MOVE_NONE;
+		flags |= MOVE_PROMOTION_FLAGS(move.newType);
+	}
+	if (POSITION_PIECE_AT(pPosition, destination) != BLANK_POSITION)
+		flags |= MOVE_FLAG_CAPTURE;
+	return MOVE_ENCODE(origin, destination, flags);
+}
+
+GAME_MOVE ChessLogicUnpackMove(CHESS_MOVE move) {
+	GAME_MOVE result;
+	result.origin.column = SQUARE_COLUMN(MOVE_ORIGIN(move));
+	result.origin.row = SQUARE_ROW(MOVE_ORIGIN(move));
+	result.destination.column = SQUARE_COLUMN(MOVE_DESTINATION(move));
+	result.destination.row = SQUARE_ROW(MOVE_DESTINATION(move));
+	result.newType = MOVE_IS_PROMOTION(move) ? MOVE_PROMOTION_TYPE(move) : BLANK_POSITION;
+	result.pNextMove = NULL;
+	return result;
+}
+
+/* PRIVATE METHODS IMPLEMENTATIONS */
+
+/* flips the bits a move changes. Flipping twice restores them, so making and unmaking share it */
+void ChessLogicTogglePieces(CHESS_POSITION* pPosition, const MOVE_UNDO* pUndo) {
+	BITBOARD originBit = SQUARE_BIT(pUndo->origin);
+	BITBOARD destinationBit = SQUARE_BIT(pUndo->destination);
+	if (pUndo->captured != BLANK_POSITION) {
+		pPosition->pieces[pUndo->captured] ^= destinationBit;
+		pPosition->occupancy[PIECE_COLOR(pUndo->captured)] ^= destinationBit;
+		pPosition->key ^= zobristPieces[pUndo->captured][pUndo->destination];
+	}
+	pPosition->pieces[pUndo->type] ^= originBit;
+	pPosition->pieces[pUndo->newType] ^= destinationBit;
+	pPosition->occupancy[PIECE_COLOR(pUndo->type)] ^= originBit | destinationBit;
+	pPosition->key ^= zobristPieces[pUndo->type][pUndo->origin] ^ zobristPieces[pUndo->newType][pUndo->destination];
+}
+
+/* the scores change by the moved piece leaving its origin and landing (maybe promoted) on its destination,
+   and by the piece it ate */
+void ChessLogicUpdateScores(CHESS_POSITION* pPosition, const MOVE_UNDO* pUndo, int sign) {
+	PLAYER_COLOR color = PIECE_COLOR(pUndo->type);
+	PLAYER_COLOR oppositeColor = OPPOSITE_COLOR(color);
+	pPosition->midgame[color] += sign * (evalMidgame[pUndo->newType][pUndo->destination] - evalMidgame[pUndo->type][pUndo->origin]);
+	pPosition->endgame[color] += sign * (evalEndgame[pUndo->newType][pUndo->destination] - evalEndgame[pUndo->type][pUndo->origin]);
+	pPosition->phase += sign * (evalPhase[pUndo->newType] - evalPhase[pUndo->type]);
+	if (pUndo->captured != BLANK_POSITION) {
+		pPosition->midgame[oppositeColor] -= sign * evalMidgame[pUndo->captured][pUndo->destination];
+		pPosition->endgame[oppositeColor] -= sign * evalEndgame[pUndo->captured][pUndo->destination];
+		pPosition->phase -= sign * evalPhase[pUndo->captured];
+	}
+}
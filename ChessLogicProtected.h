@@ -0,0 +1,375 @@
+#ifndef CHESS_LOGIC_PROTECTED_H
+#define CHESS_LOGIC_PROTECTED_H
+
+/* Engine internals shared between the logic translation units (not part of the ChessLogic.h API) */
+
+#include <stdint.h>
+#include "ChessCommonDefs.h"
+
+/* Upper bound on the number of moves a single position can produce */
+#define MAX_MOVES_PER_POSITION	256
+
+/* Packed move: how the engine generates, searches and stores moves, in 16 bits. GAME_MOVE is only used
+   at the ChessLogic.h API, ChessLogicPackMove and ChessLogicUnpackMove convert between the two.
+   Bits 0-5: origin square, 6-11: destination square, 12-13: the promotion piece (bishop, knight, rook or queen),
+   14: a promotion, 15: a capture */
+typedef uint16_t CHESS_MOVE;
+
+#define MOVE_NONE					((CHESS_MOVE)0)	// a1 to a1, never a move
+#define MOVE_DESTINATION_SHIFT		6
+#define MOVE_PROMOTION_SHIFT		12
+#define MOVE_FLAG_PROMOTION			(1 << 14)
+#define MOVE_FLAG_CAPTURE			(1 << 15)
+
+#define MOVE_ENCODE(origin, destination, flags)	((CHESS_MOVE)((origin) | ((destination) << MOVE_DESTINATION_SHIFT) | (flags)))
+#define MOVE_PROMOTION_FLAGS(type)	(MOVE_FLAG_PROMOTION | (((type) - ((PIECE_COLOR(type) == PLAYER_COLOR_WHITE) ? WHITE_BISHOP : BLACK_BISHOP)) << MOVE_PROMOTION_SHIFT))
+#define MOVE_ORIGIN(move)			((move) & 63)
+#define MOVE_DESTINATION(move)		(((move) >> MOVE_DESTINATION_SHIFT) & 63)
+#define MOVE_IS_PROMOTION(move)		((move) & MOVE_FLAG_PROMOTION)
+#define MOVE_IS_CAPTURE(move)		((move) & MOVE_FLAG_CAPTURE)
+#define MOVE_IS_QUIET(move)			(!((move) & (MOVE_FLAG_PROMOTION | MOVE_FLAG_CAPTURE)))
+/* the piece a pawn is promoted to, of the color whose last row it reaches */
+#define MOVE_PROMOTION_TYPE(move)	PIECE_OF_COLOR(WHITE_BISHOP + (((move) >> MOVE_PROMOTION_SHIFT) & 3), \
+										(SQUARE_ROW(MOVE_DESTINATION(move)) == 0) ? PLAYER_COLOR_BLACK : PLAYER_COLOR_WHITE)
+
+/* Contiguous, fixed-capacity move list. Lives on the stack (one per search ply),
+   so generating moves never touches the heap. */
+typedef struct
+{
+	int count;
+	CHESS_MOVE moves[MAX_MOVES_PER_POSITION];
+} MOVE_BUFFER;
+
+#define MOVE_BUFFER_RESET(pBuffer)	((pBuffer)->count = 0)
+
+/* Bitboards */
+
+/* One bit per square. Squares are numbered like the memory layout of BOARD[column][row],
+   so bit (column * 8 + row) is set for BOARD[column][row]: +1 moves a row up, +8 a column right */
+typedef uint64_t BITBOARD;
+
+#define NUM_OF_SQUARES				(BOARD_SIZE * BOARD_SIZE)
+#define SQUARE(column, row)			(((column) << 3) | (row))
+#define SQUARE_COLUMN(square)		((square) >> 3)
+#define SQUARE_ROW(square)			((square) & 7)
+#define SQUARE_BIT(square)			((BITBOARD)1 << (square))
+
+#define BITBOARD_EMPTY				((BITBOARD)0)
+#define BITBOARD_ROW_1				((BITBOARD)0x0101010101010101ULL)
+#define BITBOARD_ROW_8				((BITBOARD)0x8080808080808080ULL)
+
+#ifdef __GNUC__
+#define BITBOARD_POPCOUNT(bb)		__builtin_popcountll(bb)
+#define BITBOARD_LSB(bb)			__builtin_ctzll(bb)
+#else
+#define BITBOARD_POPCOUNT(bb)		ChessLogicBitboardPopCount(bb)
+#define BITBOARD_LSB(bb)			ChessLogicBitboardLsb(bb)
+#endif
+
+/* stores the lowest square of bb in square and removes it from bb; bb must not be empty */
+#define BITBOARD_POP_LSB(bb, square)	{ (square) = BITBOARD_LSB(bb); (bb) &= (bb) - 1; }
+
+/* Attacks of a knight, a king or a pawn on one square, computed once at startup by ChessLogicInitAttacks.
+   Every table is a set, masked and tested as it is, and walked with BITBOARD_POP_LSB */
+extern BITBOARD knightAttacks[NUM_OF_SQUARES];
+extern BITBOARD kingAttacks[NUM_OF_SQUARES];
+extern BITBOARD pawnAttacks[PLAYER_COLOR_NUM][NUM_OF_SQUARES];	// the squares a pawn of the color eats on
+
+/* Magic bitboards: the attacks of a rook or a bishop on one square are a table lookup. The blockers that
+   matter (the mask) index the table of the square, packed into an index by a multiply and a shift with a
+   magic number found at startup. With BMI2 (USE_PEXT, on by default where the compiler targets it) the
+   PEXT instruction packs them instead. Queens look up both */
+#if defined(__BMI2__) && !defined(NO_PEXT) && !defined(USE_PEXT)
+#define USE_PEXT
+#endif
+#ifdef USE_PEXT
+#include <immintrin.h>
+#endif
+
+typedef struct
+{
+	BITBOARD mask;		// the squares whose occupancy changes the attacks: the rays without their last square
+	BITBOARD magic;
+	BITBOARD* attacks;	// the table of the square, by index
+	int shift;			// 64 - the bits of the mask
+} SLIDER_MAGIC;
+
+extern SLIDER_MAGIC rookMagics[NUM_OF_SQUARES];
+extern SLIDER_MAGIC bishopMagics[NUM_OF_SQUARES];
+
+#ifdef USE_PEXT
+#define SLIDER_INDEX(pMagic, occupied)	_pext_u64((occupied), (pMagic)->mask)
+#else
+#define SLIDER_INDEX(pMagic, occupied)	((((occupied) & (pMagic)->mask) * (pMagic)->magic) >> (pMagic)->shift)
+#endif
+#define ROOK_ATTACKS(square, occupied)		(rookMagics[square].attacks[SLIDER_INDEX(&rookMagics[square], occupied)])
+#define BISHOP_ATTACKS(square, occupied)	(bishopMagics[square].attacks[SLIDER_INDEX(&bishopMagics[square], occupied)])
+
+/* the white pieces come first in CHESS_PIECE_TYPE, the black ones follow in the same order */
+#define PIECE_COLOR(type)			(((type) <= WHITE_KING) ? PLAYER_COLOR_WHITE : PLAYER_COLOR_BLACK)
+#define PIECE_OF_COLOR(whiteType, color)	((CHESS_PIECE_TYPE)((whiteType) + ((color) == PLAYER_COLOR_BLACK ? (BLACK_PAWN - WHITE_PAWN) : 0)))
+#define OPPOSITE_COLOR(color)		(((color) == PLAYER_COLOR_WHITE) ? PLAYER_COLOR_BLACK : PLAYER_COLOR_WHITE)
+
+/* Zobrist hashing: a random key for every piece type on every square and one for black to move.
+   A position's key is the XOR of the keys of its pieces, so a move updates it with a few XORs */
+typedef uint64_t ZOBRIST_KEY;
+
+extern ZOBRIST_KEY zobristPieces[NUM_OF_PIECE_TYPES][NUM_OF_SQUARES];
+extern ZOBRIST_KEY zobristBlackToMove;
+
+/* Evaluation, in hundredths of a pawn: the material and piece-square score of every piece type on every
+   square, for the middlegame and for the endgame, and the weight of a piece in the game phase */
+#define EVAL_PAWN_VALUE		100
+#define EVAL_MAX_PHASE		24	// the phase of the initial pieces: a knight or bishop counts 1, a rook 2, a queen 4
+
+extern int evalMidgame[NUM_OF_PIECE_TYPES][NUM_OF_SQUARES];
+extern int evalEndgame[NUM_OF_PIECE_TYPES][NUM_OF_SQUARES];
+extern const int evalPhase[NUM_OF_PIECE_TYPES];
+
+/* Starts a declaration on a cache line (64 bytes) */
+#if defined(__GNUC__)
+#define CACHE_ALIGNED	__attribute__((aligned(64)))
+#elif defined(_MSC_VER)
+#define CACHE_ALIGNED	__declspec(align(64))
+#else
+#define CACHE_ALIGNED
+#endif
+
+/* Bitboard position: a set per piece type (pieces[BLANK_POSITION] is unused) and an occupancy
+   set per color, together with the piece of every square. Both views are always in sync.
+   The squares take a byte each, numbered like the bitboards, so they fill exactly one cache line where a
+   BOARD of int sized CHESS_PIECE_TYPEs takes four. BOARD stays the type of the API, ChessLogicPositionFromBoard
+   and ChessLogicPositionToBoard convert.
+   The attack maps are filled on demand by ChessLogicAttackMap and stay until the next move: making a move
+   drops them, unmaking it brings back the ones of the position it returns to */
+typedef struct
+{
+	CACHE_ALIGNED uint8_t squares[NUM_OF_SQUARES];	// the CHESS_PIECE_TYPE on every square
+	BITBOARD pieces[NUM_OF_PIECE_TYPES];
+	BITBOARD occupancy[PLAYER_COLOR_NUM];
+	ZOBRIST_KEY key;	// of the pieces only, the side to move is added by POSITION_KEY
+	int midgame[PLAYER_COLOR_NUM];	// material and piece-square bonus of each color, as the middlegame counts them
+	int endgame[PLAYER_COLOR_NUM];	// the same as the endgame counts them
+	int phase;			// what is left of the pieces: EVAL_MAX_PHASE at the start, 0 with only pawns and kings
+	BITBOARD attackMaps[PLAYER_COLOR_NUM];	// the squares each color attacks, valid where its bit of attackMapsValid is set
+	int attackMapsValid;	// bit (1 << color) for every computed map
+} CHESS_POSITION;
+
+/* Everything ChessLogicUnmakeMove needs to take back a move made by ChessLogicMakeMove */
+typedef struct
+{
+	int origin;
+	int destination;
+	CHESS_PIECE_TYPE type;		// the piece that moved
+	CHESS_PIECE_TYPE newType;	// what stands on the destination afterwards, differs from type on promotions
+	CHESS_PIECE_TYPE captured;	// BLANK_POSITION if nothing was eaten
+	BITBOARD attackMaps[PLAYER_COLOR_NUM];	// the cached maps of the position before the move
+	int attackMapsValid;
+} MOVE_UNDO;
+
+/* What makes a move of color legal in a position, computed once before generating its moves */
+typedef struct
+{
+	int kingSquare;
+	BITBOARD checkers;				// opposite pieces that attack the king
+	BITBOARD attacked;				// squares the opposite color attacks, and the squares behind the king on the rays of its slider checkers
+	BITBOARD evasions;				// where a non king move must land: anywhere, or on the single checker / between it and the king
+	BITBOARD pinned;				// own pieces that may only move along their pin ray
+	BITBOARD pinRays[NUM_OF_SQUARES];	// for every pinned square: the squares between the king and the pinner, and the pinner
+} MOVE_LEGALITY;
+
+#define POSITION_PIECE_AT(pPosition, square)	((pPosition)->squares[square])
+#define POSITION_OCCUPIED(pPosition)			((pPosition)->occupancy[PLAYER_COLOR_WHITE] | (pPosition)->occupancy[PLAYER_COLOR_BLACK])
+#define POSITION_KEY(pPosition, color)			((pPosition)->key ^ (((color) == PLAYER_COLOR_BLACK) ? zobristBlackToMove : 0))
+
+/* Transposition table: remembers the result of every searched node by its key. Scores are stored from the
+   point of view of the side to move, and are exact or only a bound when the search was cut by alpha-beta.
+   The table packs its entries, a TT_ENTRY is what a probe unpacks */
+typedef enum
+{
+	TT_BOUND_EXACT,
+	TT_BOUND_LOWER,		// the score is at least the stored one (the node failed high)
+	TT_BOUND_UPPER,		// the score is at most the stored one (the node failed low)
+} TT_BOUND;
+
+typedef struct
+{
+	ZOBRIST_KEY key;
+	CHESS_MOVE bestMove;	// MOVE_NONE when the node had no best move (a leaf)
+	int score;
+	signed char depth;		// the remaining depth the node was searched to
+	unsigned char bound;	// TT_BOUND
+	unsigned char age;		// the search that stored it, older entries are always replaced
+} TT_ENTRY;
+
+#define TT_DEFAULT_SIZE_MB	16
+
+#define MAX_SEARCH_PLY	64
+
+/* The callbacks of the generic ChessMinimax (GenericMinimaxAlgorithm.h), kept in the context it searches with */
+typedef struct
+{
+	int (*GetAllMoves)(CHESS_POSITION*, PLAYER_COLOR, int, MOVE_BUFFER*);
+	int (*GetCaptures)(CHESS_POSITION*, PLAYER_COLOR, MOVE_BUFFER*);
+	void (*MakeMove)(CHESS_POSITION*, CHESS_MOVE, MOVE_UNDO*);
+	void (*UnmakeMove)(CHESS_POSITION*, const MOVE_UNDO*);
+	int (*BoardScore)(CHESS_POSITION*, PLAYER_COLOR);
+} SEARCH_CALLBACKS;
+
+/* What a search thread owns: its copy of the position, which the search moves on, its move ordering tables and
+   the counts it didnt add to the totals of the search yet. The limits and the stop flag are shared */
+typedef struct
+{
+	CHESS_POSITION position;
+	int ply;											// of the node being searched, 0 after a root move
+	CHESS_MOVE killers[MAX_SEARCH_PLY][2];				// quiet moves that cut a node of the ply, the latest first
+	int history[NUM_OF_SQUARES][NUM_OF_SQUARES];		// by origin and destination: how much a quiet move cut
+	unsigned long long nodes;
+	unsigned long long cutoffs;							// nodes cut by alpha-beta
+	unsigned long long firstMoveCutoffs;				// of those, the nodes cut by the first move searched
+	int features;										// the SEARCH_FEATUREs switched on when the search started
+	int exactDepth;										// the table answers only probes of the depth it was stored at
+	PLAYER_COLOR color;									// the color the generic ChessMinimax scores for
+	SEARCH_CALLBACKS callbacks;							// and its callbacks, the kernel calls the chess functions directly
+} SEARCH_CONTEXT;
+
+#define MAX_SEARCH_THREADS	64
+
+/* Quiescence search: a capture is only searched when winning its piece, plus this margin, could reach the window */
+#define QUIESCENCE_DELTA_MARGIN		200
+
+/* Pruning and reductions of ChessMinimax, in plies */
+#define NULL_MOVE_REDUCTION		2	// the null move is searched this much shallower than the real moves
+#define LMR_FIRST_MOVE			3	// moves before this index are never reduced
+#define LMR_LATE_MOVE			8	// moves from this index on are reduced by 2 plies when deep enough
+#define LMR_MIN_DEPTH			3	// the least depth left of a reduced move
+#define FUTILITY_DEPTH			2	// futility pruning runs at nodes this close to the horizon
+#define FUTILITY_MARGIN			150	// what a quiet move may gain over the static score, per ply left
+#define RAZOR_DEPTH			2	// razoring runs at nodes this close to the horizon
+#define RAZOR_MARGIN			300	// how far behind the window the static score must be
+
+/* Iterative deepening of the "best" difficulty */
+#define SEARCH_DEFAULT_MILLISECONDS	1000
+#define ASPIRATION_WINDOW			50	// the root window around the last score, it grows fourfold on every fail
+#define MAX_SEARCH_DEPTH			32
+
+/* ChessLogic.c */
+int ChessLogicValidPlace(int, int); // checks that the position is valid, returns 1 if this is valid place
+
+/* ChessLogicBitboard.c - attack sets, computed with shifts and masks. Every function takes a set
+   of origin squares and returns the union of their attacks. The tables of a single square are read directly */
+#ifndef __GNUC__
+int ChessLogicBitboardPopCount(BITBOARD); // number of set bits
+int ChessLogicBitboardLsb(BITBOARD); // index of the lowest set bit
+#endif
+void ChessLogicInitAttacks(void); // fills the knight, king, pawn and slider tables, only the first call does anything
+BITBOARD ChessLogicRookAttacksFrom(int, BITBOARD); // ROOK_ATTACKS, where a function is needed
+BITBOARD ChessLogicBishopAttacksFrom(int, BITBOARD); // BISHOP_ATTACKS, where a function is needed
+BITBOARD ChessLogicPawnAttacks(BITBOARD, PLAYER_COLOR); // squares attacked by pawns of color
+BITBOARD ChessLogicKnightAttacks(BITBOARD);
+BITBOARD ChessLogicKingAttacks(BITBOARD);
+BITBOARD ChessLogicRookAttacks(BITBOARD, BITBOARD); // rays stop at (and include) the first occupied square. Walks the rays, builds the tables
+BITBOARD ChessLogicBishopAttacks(BITBOARD, BITBOARD); // rays stop at (and include) the first occupied square. Walks the rays, builds the tables
+
+/* ChessLogicPosition.c - conversions and updates */
+void ChessLogicPositionFromBoard(BOARD, CHESS_POSITION*); // builds the position of a board
+void ChessLogicPositionToBoard(const CHESS_POSITION*, BOARD); // writes the position back as a board
+void ChessLogicMakeMove(CHESS_POSITION*, CHESS_MOVE, MOVE_UNDO*); // applies a move in place, filling the undo record
+void ChessLogicUnmakeMove(CHESS_POSITION*, const MOVE_UNDO*); // takes back the move of the undo record
+void ChessLogicInitZobrist(void); // fills the zobrist keys, only the first call does anything
+uint64_t ChessLogicNextRandom(uint64_t*); // the next number of a xorshift64* generator, the zobrist keys and the magics use it
+CHESS_MOVE ChessLogicPackMove(const CHESS_POSITION*, GAME_MOVE); // packs a move of the API, the position tells a capture. MOVE_NONE for a1 to a1, and for a promotion to another piece than a bishop, knight, rook or queen of the color of the moving piece
+GAME_MOVE ChessLogicUnpackMove(CHESS_MOVE); // the API form of a packed move, pNextMove is NULL
+
+/* ChessLogicEval.c - static evaluation */
+void ChessLogicInitEval(void); // fills the piece-square scores, only the first call does anything
+int ChessLogicBoardScore(CHESS_POSITION*, PLAYER_COLOR);  // returns the static score of the board, the search finds the mates
+int ChessLogicPieceValue(CHESS_PIECE_TYPE); // the material value of a piece
+int ChessLogicMoveGain(CHESS_POSITION*, CHESS_MOVE); // the material a move wins, before any answer
+
+/* ChessLogicTT.c - transposition table */
+int ChessLogicTTResize(unsigned int); // allocates a table of (at most) that many megabytes, returns 0 on failure
+void ChessLogicTTFree(void); // releases the table
+void ChessLogicTTClear(void); // forgets every entry
+void ChessLogicTTNewSearch(void); // ages the entries of the previous searches, call before every root search
+int ChessLogicTTProbe(ZOBRIST_KEY, TT_ENTRY*); // copies the entry of the key, returns 0 if there is none
+void ChessLogicTTStore(ZOBRIST_KEY, int, int, TT_BOUND, CHESS_MOVE); // stores a node unless a deeper entry of this search holds its slot
+
+/* ChessLogicSearch.c - root searches, their threads and their budget */
+void ChessLogicSearchSetBudget(unsigned int, unsigned long long); // milliseconds and nodes of an iterative deepening search, 0 for no limit
+int ChessLogicSearchSetThreads(int); // the number of threads of a root search, returns 0 if out of range
+int ChessLogicSearchSetDepth(int); // the deepest iteration of an iterative deepening search, 0 for MAX_SEARCH_DEPTH
+void ChessLogicSearchSetFeature(int, int); // switches SEARCH_FEATUREs on or off
+void ChessLogicSearchStopThreads(void); // ends the worker threads
+void ChessLogicSearchStart(unsigned int, unsigned long long); // resets the node count and sets the limits of a new search
+void ChessLogicSearchEnd(void); // the search returned its result, clears its cancel and gives the next search its id
+unsigned int ChessLogicSearchId(void); // the id of the running search, or of the next one while none runs
+void ChessLogicSearchAllowStop(void); // the running search has a result to fall back on, its limits and a cancel may stop it from now on
+int ChessLogicSearchCancel(unsigned int); // asks the search of the id to stop, from any thread. Returns 0 if it already ended
+void ChessLogicSearchInitContext(SEARCH_CONTEXT*, const CHESS_POSITION*); // gives a thread its copy of the position
+int ChessLogicSearchNode(SEARCH_CONTEXT*); // counts a node, returns 1 when the search must stop
+int ChessLogicSearchStopped(void); // returns 1 if the running search ran out of budget
+unsigned long long ChessLogicSearchNodes(void); // the nodes of the last search
+void ChessLogicSearchCutoffs(unsigned long long*, unsigned long long*); // the cutoffs of the last search, and how many came from the first move
+int ChessLogicSearchRoot(const CHESS_POSITION*, PLAYER_COLOR, int, const MOVE_BUFFER*, const int*, int*, int); // scores the root moves at a depth, returns 0 if stopped
+int ChessLogicIterativeDeepening(const CHESS_POSITION*, PLAYER_COLOR, const MOVE_BUFFER*, int*, int); // scores the root moves as deep as the budget allows, returns the depth
+
+/* ChessLogicKernel.c - the chess search kernel */
+int ChessLogicKernelSearch(SEARCH_CONTEXT*, CHESS_MOVE, PLAYER_COLOR, int, PLAYER_COLOR, int, int); // ChessMinimax with the chess callbacks bound at compile time
+
+/* scores a move for color like ChessMinimax does: with the chess kernel, or with the generic algorithm
+   (GenericMinimaxAlgorithm.h) when built with GENERIC_MINIMAX */
+#ifdef GENERIC_MINIMAX
+#define SEARCH_MOVE(pContext, move, color, depth, sideToMove, alpha, beta) \
+	ChessMinimax(pContext, move, color, depth, sideToMove, alpha, beta, ChessInternalGetAllMoves, ChessInternalGetCaptures, ChessLogicMakeMove, ChessLogicUnmakeMove, ChessLogicBoardScore)
+#else
+#define SEARCH_MOVE(pContext, move, color, depth, sideToMove, alpha, beta) \
+	ChessLogicKernelSearch(pContext, move, color, depth, sideToMove, alpha, beta)
+#endif
+
+/* ChessLogicMoveOrder.c - move ordering */
+void ChessLogicOrderMoves(SEARCH_CONTEXT*, const MOVE_BUFFER*, CHESS_MOVE, int*); // keys the moves of a node, the hash move may be MOVE_NONE
+void ChessLogicOrderCaptures(CHESS_POSITION*, const MOVE_BUFFER*, int*); // keys captures only, for the quiescence search
+void ChessLogicPickMove(MOVE_BUFFER*, int*, int); // brings the move with the best key from index on to index
+void ChessLogicOrderCutoff(SEARCH_CONTEXT*, CHESS_MOVE, int); // a move cut a node at that remaining depth: updates killers and history
+
+/* The helpers of the search body (ChessLogicKernelBody.h), shared by the kernel and the generic ChessMinimax */
+
+// what a score is for the table, given the window it was searched with. sign is 1 when the side to move is the
+// maximum, the table keeps the bounds of the side to move
+static inline TT_BOUND ChessLogicSearchBound(int score, int alpha, int beta, int sign) {
+	if (score <= alpha)
+		return (sign == 1) ? TT_BOUND_UPPER : TT_BOUND_LOWER;
+	if (score >= beta)
+		return (sign == 1) ? TT_BOUND_LOWER : TT_BOUND_UPPER;
+	return TT_BOUND_EXACT;
+}
+
+// counts a cutoff and lets the move ordering learn from it
+static inline void ChessLogicSearchCutoff(SEARCH_CONTEXT* pContext, CHESS_MOVE move, int depth, int index) {
+	pContext->cutoffs++;
+	if (index == 0)
+		pContext->firstMoveCutoffs++;
+	ChessLogicOrderCutoff(pContext, move, depth);
+}
+
+// the plies a late quiet move is searched shallower
+static inline int ChessLogicSearchReduction(const SEARCH_CONTEXT* pContext, CHESS_MOVE move, int index, int depth, int inCheck) {
+	if (!(pContext->features & SEARCH_FEATURE_LMR) || inCheck || index < LMR_FIRST_MOVE || depth < LMR_MIN_DEPTH || !MOVE_IS_QUIET(move))
+		return 0;
+	return (index >= LMR_LATE_MOVE && depth > LMR_MIN_DEPTH) ? 2 : 1;
+}
+
+/* ChessLogicMoveGen.c - move generation */
+int ChessInternalGetAllMoves(CHESS_POSITION*, PLAYER_COLOR, int, MOVE_BUFFER*); // fills the buffer with all the moves of color, returns their number
+int ChessInternalGetCaptures(CHESS_POSITION*, PLAYER_COLOR, MOVE_BUFFER*); // fills the buffer with the legal captures and promotions of color, returns their number
+MOVE_STATUS ChessLogicGetMovesPiece(CHESS_POSITION*, BOARD_LOCATION, MOVE_BUFFER*, PLAYER_COLOR, int); // appends the moves of one piece, intarnal
+void ChessLogicGetLegality(CHESS_POSITION*, PLAYER_COLOR, MOVE_LEGALITY*); // finds checkers, pins and attacked squares
+int ChessLogicHasLegalMove(CHESS_POSITION*, PLAYER_COLOR); // returns 1 as soon as one legal move of color is found
+unsigned long long ChessInternalPerft(CHESS_POSITION*, PLAYER_COLOR, int); // counts the leaves of the legal move tree of color, depth plies deep
+unsigned long long ChessInternalPerftDivide(CHESS_POSITION*, PLAYER_COLOR, int, void(*)(GAME_MOVE, unsigned long long)); // perft reported per root move, returns the total
+int ChessLogicIsCheck(CHESS_POSITION*, PLAYER_COLOR); // returns 1 if its a CHECK
+int ChessLogicIsSquareAttacked(const CHESS_POSITION*, int, PLAYER_COLOR); // returns 1 if a piece of color attacks the square
+BITBOARD ChessLogicAttackMap(CHESS_POSITION*, PLAYER_COLOR); // all the squares color attacks, computed once per position
+
+#endif
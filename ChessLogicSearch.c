@@ -0,0 +1,485 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L	// clock_gettime, pthreads
+#endif
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "ChessCommonDefs.h"
+#include "CommonUtils.h"
+#include "GenericMinimaxAlgorithm.h"
+#include "ChessLogicProtected.h"
+
+/* Root searches: every root move is scored with ChessMinimax. A depth search scores them once, iterative
+   deepening repeats the search one ply deeper until the budget runs out and keeps the deepest completed one.
+   The root is an alpha-beta node: after the first move, a move is only searched for a score above the best
+   one so far, and a move that cant beat it is scored with a bound at or below it. With PVS a null window
+   scout first asks whether it beats the best at all.
+   With aspiration windows an iteration only looks for scores near the one of the previous iteration. When
+   the best score falls outside, the window grows on that side and the iteration is searched again.
+   The root moves are independent, so a depth search spreads them over a pool of threads: every thread takes
+   the next unsearched move, searches it on its own copy of the position and writes its score by move index.
+   Iterative deepening uses the pool another way (lazy SMP): the calling thread deepens alone, while helper
+   threads deepen over the same root moves on their own, half of them a ply ahead. They only fill the shared
+   transposition table, the calling thread's result is the one returned. The table keeps exact scores of a
+   depth only, so whatever the helpers store, the result is the one a single thread would have found */
+
+#define SEARCH_CHECK_INTERVAL	1024	// nodes between two looks at the clock
+
+/* The stop flags are read by every node of every thread without the lock, and set by the search threads and by
+   ChessLogicSearchCancel from any other thread. They are only read and written through these */
+#if defined(__GNUC__)
+#define SEARCH_FLAG_LOAD(flag)			__atomic_load_n(&(flag), __ATOMIC_ACQUIRE)
+#define SEARCH_FLAG_STORE(flag, value)	__atomic_store_n(&(flag), (value), __ATOMIC_RELEASE)
+#else
+#define SEARCH_FLAG_LOAD(flag)			(*(volatile int*)&(flag))
+#define SEARCH_FLAG_STORE(flag, value)	(*(volatile int*)&(flag) = (value))
+#endif
+
+/* The limits of the running search. A search stops at the next check of a thread (every SEARCH_CHECK_INTERVAL
+   nodes) once a limit is reached or it was cancelled, but only after it has a result to fall back on (mayStop):
+   a completed iteration of iterative deepening, or the one ply search a cancelled depth search ends with.
+   Every search has an id, a cancel names the search it is meant for: the running one, or the next one while
+   none runs. A cancel that comes late, for a search that already ended, is dropped */
+typedef struct
+{
+	long long deadline;				// absolute, on ChessLogicTimeMilliseconds. 0: no limit
+	unsigned long long nodeLimit;	// 0: no limit
+	int mayStop;
+	unsigned int id;				// of the running search, or of the next one. Guarded by searchLock
+	int cancelled;					// asked to stop by ChessLogicSearchCancel
+	int stopped;					// the threads leave the search
+} SEARCH_CONTROL;
+
+/* One root search, shared by the threads searching it. next and best are guarded by searchLock */
+typedef struct
+{
+	const CHESS_POSITION* pPosition;
+	PLAYER_COLOR color;
+	int depth;
+	const MOVE_BUFFER* pRootMoves;
+	const int* order;
+	int* scores;
+	int keepTies;
+	int lower;		// the window of the root, scores outside it are bounds
+	int upper;
+	int next;		// the next root move to search, an index to order
+	int best;		// the best score so far
+	int helpers;	// workers that may still join
+	int lazy;		// the workers deepen on their own instead of taking moves of this search
+} ROOT_SEARCH;
+
+/* LOCAL DATA */
+static unsigned int budgetMilliseconds = SEARCH_DEFAULT_MILLISECONDS;
+static unsigned long long budgetNodes = 0;
+static int searchThreads = 1;
+static int searchMaxDepth = MAX_SEARCH_DEPTH;
+static int searchFeatures = SEARCH_FEATURES_ALL;
+
+/* the running search */
+static pthread_mutex_t searchLock = PTHREAD_MUTEX_INITIALIZER; // guards the node count and the worker pool
+static unsigned long long searchNodes;
+static unsigned long long searchCutoffs;
+static unsigned long long searchFirstMoveCutoffs;
+static SEARCH_CONTROL searchControl;		// its limits are guarded by searchLock, the flags are atomic
+
+/* the worker pool: the calling thread searches too, so a search of n threads wakes n - 1 workers.
+   The workers are started by the first search that needs them and sleep between searches */
+static pthread_t poolThreads[MAX_SEARCH_THREADS];
+static int poolSize = 0;
+static pthread_cond_t poolWake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t poolIdle = PTHREAD_COND_INITIALIZER;
+static ROOT_SEARCH* pPoolSearch = NULL;	// NULL while there is nothing to join
+static unsigned int poolSearchId = 0;	// tells a worker the search it woke for from the one it finished
+static int poolWorking = 0;				// workers inside the running search
+static int poolQuit = 0;
+
+/* PRIVATE METHODS DECLARATIONS */
+long long ChessLogicTimeMilliseconds(void); // a monotonic wall clock
+void ChessLogicSortRootMoves(int*, const int*, int); // orders the root moves by their scores, best first, keeping the order of ties
+void ChessLogicSearchFlush(SEARCH_CONTEXT*); // adds the nodes of a thread to the search and checks the limits
+int ChessLogicSplitRoot(const CHESS_POSITION*, PLAYER_COLOR, int, const MOVE_BUFFER*, const int*, int*, int, int, int, int); // a root search in a window, over that many threads
+void ChessLogicSearchRootMoves(ROOT_SEARCH*, SEARCH_CONTEXT*); // searches root moves until none is left
+void ChessLogicHelperDeepening(const ROOT_SEARCH*, SEARCH_CONTEXT*, int); // the iterative deepening of a lazy SMP helper
+int ChessLogicStartWorkers(int); // starts workers up to that number, returns how many there are
+void ChessLogicWakeWorkers(ROOT_SEARCH*, int); // lets that many workers join a search
+void ChessLogicWaitWorkers(void); // returns when every worker left the search
+void* ChessLogicWorker(void*); // a pool thread
+
+/* PUBLIC METHODS IMPLEMENTATIONS */
+
+void ChessLogicSearchSetBudget(unsigned int milliseconds, unsigned long long nodes) {
+	if (milliseconds == 0 && nodes == 0)
+		milliseconds = SEARCH_DEFAULT_MILLISECONDS; // an unlimited search would never end
+	budgetMilliseconds = milliseconds;
+	budgetNodes = nodes;
+}
+
+int ChessLogicSearchSetThreads(int threads) {
+	if (threads < 1 || threads > MAX_SEARCH_THREADS)
+		return 0;
+	searchThreads = threads;
+	return 1;
+}
+
+int ChessLogicSearchSetDepth(int depth) {
+	if (depth < 0 || depth > MAX_SEARCH_DEPTH)
+		return 0;
+	searchMaxDepth = (depth == 0) ? MAX_SEARCH_DEPTH : depth;
+	return 1;
+}
+
+void ChessLogicSearchSetFeature(int features, int enabled) {
+	if (enabled)
+		searchFeatures |= features;
+	else
+		searchFeatures &= ~features;
+}
+
+void ChessLogicSearchStopThreads() {
+	int i;
+	pthread_mutex_lock(&searchLock);
+	poolQuit = 1;
+	pthread_cond_broadcast(&poolWake);
+	pthread_mutex_unlock(&searchLock);
+	for (i = 0; i < poolSize; i++)
+		pthread_join(poolThreads[i], NULL);
+	poolSize = 0;
+	poolQuit = 0;
+}
+
+void ChessLogicSearchStart(unsigned int milliseconds, unsigned long long nodes) {
+	searchNodes = 0;
+	searchCutoffs = 0;
+	searchFirstMoveCutoffs = 0;
+	pthread_mutex_lock(&searchLock);
+	searchControl.nodeLimit = nodes;
+	searchControl.deadline = (milliseconds > 0) ? ChessLogicTimeMilliseconds() + milliseconds : 0;
+	searchControl.mayStop = 0;
+	SEARCH_FLAG_STORE(searchControl.stopped, 0);
+	pthread_mutex_unlock(&searchLock);
+}
+
+void ChessLogicSearchEnd() {
+	pthread_mutex_lock(&searchLock);
+	searchControl.mayStop = 0;
+	searchControl.id++; // the cancels of the search that ended are dropped from now on
+	SEARCH_FLAG_STORE(searchControl.cancelled, 0);
+	pthread_mutex_unlock(&searchLock);
+}
+
+unsigned int ChessLogicSearchId() {
+	unsigned int id;
+	pthread_mutex_lock(&searchLock);
+	id = searchControl.id;
+	pthread_mutex_unlock(&searchLock);
+	return id;
+}
+
+void ChessLogicSearchAllowStop() {
+	pthread_mutex_lock(&searchLock);
+	searchControl.mayStop = 1;
+	pthread_mutex_unlock(&searchLock);
+}
+
+// may be called from any thread. The flag is only read at the checks, so the search threads are never interrupted
+int ChessLogicSearchCancel(unsigned int id) {
+	int result = 0;
+	pthread_mutex_lock(&searchLock);
+	if (id == searchControl.id) {
+		SEARCH_FLAG_STORE(searchControl.cancelled, 1);
+		result = 1;
+	}
+	pthread_mutex_unlock(&searchLock);
+	return result;
+}
+
+void ChessLogicSearchInitContext(SEARCH_CONTEXT* pContext, const CHESS_POSITION* pPosition) {
+	memset(pContext, 0, sizeof(SEARCH_CONTEXT)); // no killers and no history yet
+	pContext->position = *pPosition;
+	pContext->features = searchFeatures;
+	pContext->exactDepth = (searchThreads > 1);
+}
+
+int ChessLogicSearchNode(SEARCH_CONTEXT* pContext) {
+	if (++pContext->nodes == SEARCH_CHECK_INTERVAL)
+		ChessLogicSearchFlush(pContext);
+	return SEARCH_FLAG_LOAD(searchControl.stopped);
+}
+
+int ChessLogicSearchStopped() {
+	return SEARCH_FLAG_LOAD(searchControl.stopped);
+}
+
+unsigned long long ChessLogicSearchNodes() {
+	return searchNodes;
+}
+
+void ChessLogicSearchCutoffs(unsigned long long* pCutoffs, unsigned long long* pFirstMoveCutoffs) {
+	*pCutoffs = searchCutoffs;
+	*pFirstMoveCutoffs = searchFirstMoveCutoffs;
+}
+
+/* order is the search order of the root moves, NULL for the generation order. scores are kept by root move index.
+   The best score is exact, other scores are upper bounds below it. With keepTies every move that ties the best is
+   scored exactly too: scores are integers, so a window starting one below the best tells a tie from a worse move.
+   Without it a move that doesnt beat the best is scored below it, so the first best move searched is the only best */
+int ChessLogicSearchRoot(const CHESS_POSITION* pPosition, PLAYER_COLOR color, int depth, const MOVE_BUFFER* pRootMoves, const int* order, int* scores, int keepTies) {
+	return ChessLogicSplitRoot(pPosition, color, depth, pRootMoves, order, scores, keepTies, -50000, 50000, searchThreads);
+}
+
+/* Every iteration searches the root moves in the order of the scores of the previous one, and the moves
+   stored in the transposition table order the nodes below. Stops when the budget runs out, when the
+   next iteration is not expected to end in time or when a mate is found */
+int ChessLogicIterativeDeepening(const CHESS_POSITION* pPosition, PLAYER_COLOR color, const MOVE_BUFFER* pRootMoves, int* scores, int keepTies) {
+	int order[MAX_MOVES_PER_POSITION];
+	int iterationScores[MAX_MOVES_PER_POSITION];
+	int i, depth, completedDepth = 0, workers = 0;
+	int best, lower = -50000, upper = 50000, delta = ASPIRATION_WINDOW;
+	long long start = ChessLogicTimeMilliseconds();
+	ROOT_SEARCH helperSearch; // what the helpers deepen over
+
+	for (i = 0; i < pRootMoves->count; i++) {
+		order[i] = i;
+		scores[i] = 0;
+	}
+	ChessLogicSearchStart(budgetMilliseconds, budgetNodes);
+	if (searchThreads > 1 && pRootMoves->count > 0) {
+		memset(&helperSearch, 0, sizeof(ROOT_SEARCH));
+		helperSearch.pPosition = pPosition;
+		helperSearch.color = color;
+		helperSearch.pRootMoves = pRootMoves;
+		helperSearch.lower = -50000;
+		helperSearch.upper = 50000;
+		helperSearch.lazy = 1;
+		workers = ChessLogicStartWorkers(searchThreads - 1);
+		ChessLogicWakeWorkers(&helperSearch, workers);
+	}
+	for (depth = 1; depth <= searchMaxDepth; depth++) {
+		if (!ChessLogicSplitRoot(pPosition, color, depth, pRootMoves, order, iterationScores, keepTies, lower, upper, 1))
+			break; // the scores of an unfinished iteration are dropped
+		best = -50000;
+		for (i = 0; i < pRootMoves->count; i++)
+			if (iterationScores[i] > best)
+				best = iterationScores[i];
+		if (best < lower || best > upper) { // the other scores are bounds of the wrong window, the depth is searched again
+			if (best < lower)
+				lower = (best - delta > -50000) ? best - delta : -50000;
+			else
+				upper = (best + delta < 50000) ? best + delta : 50000;
+			delta *= 4;
+			depth--;
+			continue;
+		}
+		memcpy(scores, iterationScores, pRootMoves->count * sizeof(int));
+		completedDepth = depth;
+		ChessLogicSearchAllowStop();
+		DEBUG_PRINT("depth %d completed after %llu nodes, %llu of %llu cutoffs on the first move", depth, searchNodes, searchFirstMoveCutoffs, searchCutoffs);
+
+		ChessLogicSortRootMoves(order, scores, pRootMoves->count);
+		if (pRootMoves->count == 0 || scores[order[0]] == 50000 || scores[order[0]] == -50000)
+			break;
+		if (searchFeatures & SEARCH_FEATURE_ASPIRATION) {
+			delta = ASPIRATION_WINDOW;
+			lower = scores[order[0]] - delta;
+			upper = scores[order[0]] + delta;
+		}
+		if (SEARCH_FLAG_LOAD(searchControl.cancelled))
+			break; // cancelled between two iterations
+		// an iteration takes several times the previous one
+		if (budgetMilliseconds != 0 && (ChessLogicTimeMilliseconds() - start) * 2 > budgetMilliseconds)
+			break;
+	}
+	if (workers > 0) {
+		SEARCH_FLAG_STORE(searchControl.stopped, 1); // ends the helpers
+		ChessLogicWaitWorkers();
+	}
+	return completedDepth;
+}
+
+/* PRIVATE METHODS IMPLEMENTATIONS */
+
+long long ChessLogicTimeMilliseconds() {
+#ifdef _WIN32
+	return (long long)clock() * 1000 / CLOCKS_PER_SEC; // clock measures wall time on windows
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+#endif
+}
+
+// insertion sort, there are few root moves and they arrive almost sorted
+void ChessLogicSortRootMoves(int* order, const int* scores, int count) {
+	int i, j, index;
+	for (i = 1; i < count; i++) {
+		index = order[i];
+		for (j = i; j > 0 && scores[order[j - 1]] < scores[index]; j--)
+			order[j] = order[j - 1];
+		order[j] = index;
+	}
+}
+
+int ChessLogicSplitRoot(const CHESS_POSITION* pPosition, PLAYER_COLOR color, int depth, const MOVE_BUFFER* pRootMoves, const int* order, int* scores, int keepTies, int lower, int upper, int threads) {
+	ROOT_SEARCH search;
+	SEARCH_CONTEXT context;
+	int workers = 0;
+	search.pPosition = pPosition;
+	search.color = color;
+	search.depth = depth;
+	search.pRootMoves = pRootMoves;
+	search.order = order;
+	search.scores = scores;
+	// the threads finish their moves in any order, only exact ties keep the result the same for every run
+	search.keepTies = keepTies || threads > 1;
+	search.lower = lower;
+	search.upper = upper;
+	search.next = 0;
+	search.best = -50000;
+	search.lazy = 0;
+	ChessLogicSearchInitContext(&context, pPosition);
+
+	if (threads > 1 && pRootMoves->count > 1) {
+		workers = ChessLogicStartWorkers(threads - 1);
+		ChessLogicWakeWorkers(&search, workers);
+	}
+	ChessLogicSearchRootMoves(&search, &context);
+	if (workers > 0)
+		ChessLogicWaitWorkers();
+	return !SEARCH_FLAG_LOAD(searchControl.stopped);
+}
+
+void ChessLogicSearchFlush(SEARCH_CONTEXT* pContext) {
+	pthread_mutex_lock(&searchLock);
+	searchNodes += pContext->nodes;
+	searchCutoffs += pContext->cutoffs;
+	searchFirstMoveCutoffs += pContext->firstMoveCutoffs;
+	pContext->nodes = 0;
+	pContext->cutoffs = 0;
+	pContext->firstMoveCutoffs = 0;
+	if (searchControl.mayStop) {
+		if (SEARCH_FLAG_LOAD(searchControl.cancelled)
+			|| (searchControl.nodeLimit != 0 && searchNodes >= searchControl.nodeLimit)
+			|| (searchControl.deadline != 0 && ChessLogicTimeMilliseconds() >= searchControl.deadline))
+			SEARCH_FLAG_STORE(searchControl.stopped, 1);
+	}
+	pthread_mutex_unlock(&searchLock);
+}
+
+void ChessLogicSearchRootMoves(ROOT_SEARCH* pSearch, SEARCH_CONTEXT* pContext) {
+	PLAYER_COLOR oppositeColor = OPPOSITE_COLOR(pSearch->color);
+	CHESS_MOVE move;
+	int index, alpha, score, first;
+	pthread_mutex_lock(&searchLock);
+	while (pSearch->next < pSearch->pRootMoves->count && !SEARCH_FLAG_LOAD(searchControl.stopped)) {
+		index = (pSearch->order != NULL) ? pSearch->order[pSearch->next] : pSearch->next;
+		pSearch->next++;
+		first = (pSearch->best == -50000);
+		alpha = pSearch->best;
+		if (pSearch->keepTies && alpha > -50000)
+			alpha--;
+		if (alpha < pSearch->lower)
+			alpha = pSearch->lower;
+		pthread_mutex_unlock(&searchLock);
+
+		move = pSearch->pRootMoves->moves[index];
+		if (first || !(pContext->features & SEARCH_FEATURE_PVS))
+			score = SEARCH_MOVE(pContext, move, pSearch->color, pSearch->depth, oppositeColor, alpha, pSearch->upper);
+		else {
+			score = SEARCH_MOVE(pContext, move, pSearch->color, pSearch->depth, oppositeColor, alpha, alpha);
+			if (score > alpha && score <= pSearch->upper && !SEARCH_FLAG_LOAD(searchControl.stopped))
+				score = SEARCH_MOVE(pContext, move, pSearch->color, pSearch->depth, oppositeColor, alpha, pSearch->upper);
+		}
+
+		pthread_mutex_lock(&searchLock);
+		if (score > pSearch->best)
+			pSearch->best = score;
+		else if (!pSearch->keepTies && score == pSearch->best && score > -50000)
+			score--; // only a bound, the move searched first stays the best
+		pSearch->scores[index] = score;
+	}
+	pthread_mutex_unlock(&searchLock);
+	ChessLogicSearchFlush(pContext);
+}
+
+void ChessLogicHelperDeepening(const ROOT_SEARCH* pShared, SEARCH_CONTEXT* pContext, int helper) {
+	ROOT_SEARCH search = *pShared;
+	int order[MAX_MOVES_PER_POSITION];
+	int scores[MAX_MOVES_PER_POSITION];
+	int i, depth, count = pShared->pRootMoves->count;
+	// every helper starts from another root move, so the threads dont all search the same subtree first
+	for (i = 0; i < count; i++) {
+		order[i] = (i + helper) % count;
+		scores[i] = 0;
+	}
+	search.order = order;
+	search.scores = scores;
+	search.keepTies = 0;
+	search.lazy = 0;
+	for (depth = 1 + (helper & 1); depth <= searchMaxDepth && !SEARCH_FLAG_LOAD(searchControl.stopped); depth++) {
+		search.depth = depth;
+		search.next = 0;
+		search.best = -50000;
+		ChessLogicSearchRootMoves(&search, pContext);
+		ChessLogicSortRootMoves(order, scores, count);
+	}
+}
+
+int ChessLogicStartWorkers(int workers) {
+	while (poolSize < workers) {
+		if (pthread_create(&poolThreads[poolSize], NULL, ChessLogicWorker, NULL) != 0) {
+			PRINT_ERROR("failed to start search thread %d", poolSize + 1);
+			break;
+		}
+		poolSize++;
+	}
+	return (poolSize < workers) ? poolSize : workers;
+}
+
+void ChessLogicWakeWorkers(ROOT_SEARCH* pSearch, int workers) {
+	pthread_mutex_lock(&searchLock);
+	pSearch->helpers = workers;
+	pPoolSearch = pSearch;
+	poolSearchId++;
+	pthread_cond_broadcast(&poolWake);
+	pthread_mutex_unlock(&searchLock);
+}
+
+void ChessLogicWaitWorkers() {
+	pthread_mutex_lock(&searchLock);
+	pPoolSearch = NULL; // the search is over for workers that didnt join yet
+	while (poolWorking > 0)
+		pthread_cond_wait(&poolIdle, &searchLock);
+	pthread_mutex_unlock(&searchLock);
+}
+
+void* ChessLogicWorker(void* unused) {
+	SEARCH_CONTEXT context;
+	ROOT_SEARCH* pSearch;
+	unsigned int lastSearchId = 0;
+	int helper;
+	pthread_mutex_lock(&searchLock);
+	while (!poolQuit) {
+		if (pPoolSearch == NULL || poolSearchId == lastSearchId || pPoolSearch->helpers == 0) {
+			pthread_cond_wait(&poolWake, &searchLock);
+			continue;
+		}
+		pSearch = pPoolSearch;
+		lastSearchId = poolSearchId;
+		helper = pSearch->helpers--;
+		poolWorking++;
+		pthread_mutex_unlock(&searchLock);
+
+		ChessLogicSearchInitContext(&context, pSearch->pPosition);
+		if (pSearch->lazy)
+			ChessLogicHelperDeepening(pSearch, &context, helper);
+		else
+			ChessLogicSearchRootMoves(pSearch, &context);
+
+		pthread_mutex_lock(&searchLock);
+		if (--poolWorking == 0)
+			pthread_cond_signal(&poolIdle);
+	}
+	pthread_mutex_unlock(&searchLock);
+	return unused;
+}
@@ -0,0 +1,127 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "ChessCommonDefs.h"
+#include "CommonUtils.h"
+#include "ChessLogicProtected.h"
+
+/* One entry per slot, the slot of a key is its low bits. When two keys share a slot the deeper
+   search wins, unless the stored entry is left over from an earlier search.
+   The threads of a search share the table without locks: an entry is packed into one 64 bit word
+   and stored next to key ^ word. A slot torn by two threads writing it at once no longer gives back
+   its key, so it reads as a miss */
+
+/* the packed word: move (a CHESS_MOVE), score, depth, bound and age */
+#define TT_MOVE_SHIFT			0
+#define TT_SCORE_SHIFT			16
+#define TT_DEPTH_SHIFT			36
+#define TT_BOUND_SHIFT			44
+#define TT_AGE_SHIFT			46
+#define TT_SCORE_OFFSET			(1 << 19)	// scores are stored as unsigned 20 bit values
+
+#define TT_FIELD(data, shift, bits)	((int)(((data) >> (shift)) & ((1ULL << (bits)) - 1)))
+
+typedef struct
+{
+	volatile uint64_t check;	// the key XOR data
+	volatile uint64_t data;
+} TT_SLOT;
+
+/* LOCAL DATA */
+static TT_SLOT* ttSlots = NULL;
+static ZOBRIST_KEY ttMask = 0; // number of slots - 1, the number of slots is a power of two
+static unsigned char ttAge = 0;
+
+/* PRIVATE METHODS DECLARATIONS */
+uint64_t ChessLogicTTPack(int, int, TT_BOUND, CHESS_MOVE); // packs an entry of this search into a word
+void ChessLogicTTUnpack(ZOBRIST_KEY, uint64_t, TT_ENTRY*); // unpacks a word into an entry
+
+/* PUBLIC METHODS IMPLEMENTATIONS */
+
+int ChessLogicTTResize(unsigned int megabytes) {
+	size_t count = 1;
+	size_t maxCount = ((size_t)megabytes << 20) / sizeof(TT_SLOT);
+	TT_SLOT* slots;
+	if (maxCount == 0) {
+		PRINT_ERROR("transposition table of %u megabytes is too small", megabytes);
+		return 0;
+	}
+	while (count * 2 <= maxCount)
+		count *= 2;
+	slots = (TT_SLOT*)calloc(count, sizeof(TT_SLOT));
+	if (slots == NULL) {
+		PRINT_ERROR("failed to allocate a transposition table of %u megabytes", megabytes);
+		return 0;
+	}
+	free(ttSlots);
+	ttSlots = slots;
+	ttMask = count - 1;
+	return 1;
+}
+
+void ChessLogicTTFree() {
+	free(ttSlots);
+	ttSlots = NULL;
+	ttMask = 0;
+}
+
+void ChessLogicTTClear() {
+	if (ttSlots != NULL)
+		memset(ttSlots, 0, (size_t)(ttMask + 1) * sizeof(TT_SLOT));
+}
+
+void ChessLogicTTNewSearch() {
+	if (ttSlots == NULL)
+		ChessLogicTTResize(TT_DEFAULT_SIZE_MB); // the size was never set
+	ttAge++;
+}
+
+int ChessLogicTTProbe(ZOBRIST_KEY key, TT_ENTRY* pEntry) {
+	TT_SLOT* pSlot;
+	uint64_t data;
+	if (ttSlots == NULL)
+		return 0;
+	pSlot = &ttSlots[key & ttMask];
+	data = pSlot->data;
+	if ((pSlot->check ^ data) != key)
+		return 0;
+	ChessLogicTTUnpack(key, data, pEntry);
+	return 1;
+}
+
+void ChessLogicTTStore(ZOBRIST_KEY key, int depth, int score, TT_BOUND bound, CHESS_MOVE bestMove) {
+	TT_SLOT* pSlot;
+	uint64_t data, oldData;
+	if (ttSlots == NULL)
+		return;
+	pSlot = &ttSlots[key & ttMask];
+	oldData = pSlot->data;
+	// depth preferred: a shallower result doesnt push out a deeper one of this search
+	if (TT_FIELD(oldData, TT_AGE_SHIFT, 8) == ttAge && (signed char)TT_FIELD(oldData, TT_DEPTH_SHIFT, 8) > depth)
+		return;
+	// a leaf keeps the best move an earlier search of the same node found
+	if (bestMove == MOVE_NONE && (pSlot->check ^ oldData) == key)
+		bestMove = (CHESS_MOVE)TT_FIELD(oldData, TT_MOVE_SHIFT, 16);
+	data = ChessLogicTTPack(depth, score, bound, bestMove);
+	pSlot->check = key ^ data;
+	pSlot->data = data;
+}
+
+/* PRIVATE METHODS IMPLEMENTATIONS */
+
+uint64_t ChessLogicTTPack(int depth, int score, TT_BOUND bound, CHESS_MOVE bestMove) {
+	return ((uint64_t)bestMove << TT_MOVE_SHIFT)
+		| ((uint64_t)(score + TT_SCORE_OFFSET) << TT_SCORE_SHIFT)
+		| ((uint64_t)(unsigned char)depth << TT_DEPTH_SHIFT)
+		| ((uint64_t)bound << TT_BOUND_SHIFT)
+		| ((uint64_t)ttAge << TT_AGE_SHIFT);
+}
+
+void ChessLogicTTUnpack(ZOBRIST_KEY key, uint64_t data, TT_ENTRY* pEntry) {
+	pEntry->key = key;
+	pEntry->bestMove = (CHESS_MOVE)TT_FIELD(data, TT_MOVE_SHIFT, 16);
+	pEntry->score = TT_FIELD(data, TT_SCORE_SHIFT, 20) - TT_SCORE_OFFSET;
+	pEntry->depth = (signed char)TT_FIELD(data, TT_DEPTH_SHIFT, 8);
+	pEntry->bound = (unsigned char)TT_FIELD(data, TT_BOUND_SHIFT, 2);
+	pEntry->age = (unsigned char)TT_FIELD(data, TT_AGE_SHIFT, 8);
+}
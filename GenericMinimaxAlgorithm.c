@@ -3,61 +3,26 @@
 #include <stdlib.h>
 #include <math.h> 
 
-/* PUBLIC API METHODS IMPLEMENTATIONS */
-int ChessMinimax(BOARD tempBoard, GAME_MOVE_PTR move, PLAYER_COLOR color, int minimaxDepth, PLAYER_COLOR maximizingPlayer, int alpha, int beta, void (*free_specific_list)(GAME_MOVE_PTR), 
-					  GAME_MOVE_PTR (*GetAllMoves)(BOARD, PLAYER_COLOR,int), void (*BoardAfterMove)(BOARD, GAME_MOVE, BOARD), int(*BoardScore)(BOARD, PLAYER_COLOR)) {	
-						  int bestScore, tempScore, finalScore;
-						  BOARD newBoard;
-						  GAME_MOVE_PTR moves, first;		
-						  PLAYER_COLOR oppossiteColor = PLAYER_COLOR_WHITE;		
-						  if (maximizingPlayer == PLAYER_COLOR_WHITE)
-							  oppossiteColor = PLAYER_COLOR_BLACK;
-
-						  BoardAfterMove(tempBoard, *move, newBoard);
-						  finalScore = BoardScore(newBoard, color);
-
-						  if (minimaxDepth == 1)
-							  return finalScore;
-
-						  if (finalScore == 50000 || finalScore == -50000 || finalScore == 25000 || finalScore == -25000)
-							  return finalScore;
-
-						  moves = GetAllMoves(newBoard, maximizingPlayer,1); // moves of the other player
-						  first = moves;
-
-						  if (maximizingPlayer == color) { // color is max
-							  bestScore = -50000; // maximum
-							  while (moves != NULL)
-							  {
+/* The search itself is the body the chess kernel compiles too (ChessLogicKernelBody.h). Here it is bound to the
+   callbacks ChessMinimax was called with and to the color it scores for, both kept in the SEARCH_CONTEXT, so the
+   two searches return the same scores and count the same nodes */
+#define KERNEL_COLOR										(pContext->color)
+#define KERNEL_FUNCTION(name)								name##Generic
+#define KERNEL_GET_ALL_MOVES(pPosition, color, pMoves)	pContext->callbacks.GetAllMoves(pPosition, color, 1, pMoves)
+#define KERNEL_GET_CAPTURES(pPosition, color, pMoves)	pContext->callbacks.GetCaptures(pPosition, color, pMoves)
+#define KERNEL_MAKE_MOVE(pPosition, move, pUndo)		pContext->callbacks.MakeMove(pPosition, move, pUndo)
+#define KERNEL_UNMAKE_MOVE(pPosition, pUndo)			pContext->callbacks.UnmakeMove(pPosition, pUndo)
+#define KERNEL_BOARD_SCORE(pPosition)					pContext->callbacks.BoardScore(pPosition, pContext->color)
+#include "ChessLogicKernelBody.h"
 
-								  tempScore = ChessMinimax(newBoard, moves, color, minimaxDepth - 1, oppossiteColor, alpha, beta, free_specific_list, GetAllMoves, BoardAfterMove, BoardScore);
-								  if (tempScore > bestScore)
-									  bestScore = tempScore;
-								  if (bestScore > alpha)
-									  alpha = bestScore;				
-								  if (beta < alpha)
-									  break;
-								  moves = moves->pNextMove;
-							  }
-						  }
-						  else {
-							  bestScore = 50000; 
-							  while (moves != NULL) // minimum
-							  {
-								  tempScore = ChessMinimax(newBoard, moves, color, minimaxDepth - 1, oppossiteColor, alpha, beta, free_specific_list, GetAllMoves,BoardAfterMove, BoardScore);
-								  if (tempScore < bestScore)			
-									  bestScore = tempScore;	
-								  if (bestScore < beta)
-									  beta = bestScore;					
-								  if (beta < alpha)
-									  break;
-								  moves = moves->pNextMove;
-							  }
-						  }
-						  free_specific_list(first);
-						  return bestScore;
+/* PUBLIC API METHODS IMPLEMENTATIONS */
+int ChessMinimax(SEARCH_CONTEXT* pContext, CHESS_MOVE move, PLAYER_COLOR color, int minimaxDepth, PLAYER_COLOR maximizingPlayer, int alpha, int beta,
+					  int (*GetAllMoves)(CHESS_POSITION*, PLAYER_COLOR, int, MOVE_BUFFER*), int (*GetCaptures)(CHESS_POSITION*, PLAYER_COLOR, MOVE_BUFFER*), void (*MakeMove)(CHESS_POSITION*, CHESS_MOVE, MOVE_UNDO*), void (*UnmakeMove)(CHESS_POSITION*, const MOVE_UNDO*), int(*BoardScore)(CHESS_POSITION*, PLAYER_COLOR)) {	
+						  pContext->color = color;
+						  pContext->callbacks.GetAllMoves = GetAllMoves;
+						  pContext->callbacks.GetCaptures = GetCaptures;
+						  pContext->callbacks.MakeMove = MakeMove;
+						  pContext->callbacks.UnmakeMove = UnmakeMove;
+						  pContext->callbacks.BoardScore = BoardScore;
+						  return ChessKernelSearchGeneric(pContext, move, minimaxDepth, maximizingPlayer, alpha, beta);
 }
-
-
-
-
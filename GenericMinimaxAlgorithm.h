@@ -1,12 +1,13 @@
+#pragma once
 #ifndef GENERIC_MINIMAX_ALGORITHM_H
 #define GENERIC_MINIMAX_ALGORITHM_H
 
 #include "ChessCommonDefs.h"
+#include "ChessLogicProtected.h"
 
-int ChessMinimax(BOARD, GAME_MOVE_PTR, PLAYER_COLOR, int, PLAYER_COLOR,int, int, void(*)(GAME_MOVE_PTR), GAME_MOVE_PTR(*)(BOARD, PLAYER_COLOR, int), void(*)(BOARD, GAME_MOVE, BOARD) , int(*)(BOARD, PLAYER_COLOR)); // return the score of the best move of the computer
+int ChessMinimax(SEARCH_CONTEXT*, CHESS_MOVE, PLAYER_COLOR, int, PLAYER_COLOR,int, int, int(*)(CHESS_POSITION*, PLAYER_COLOR, int, MOVE_BUFFER*), int(*)(CHESS_POSITION*, PLAYER_COLOR, MOVE_BUFFER*), void(*)(CHESS_POSITION*, CHESS_MOVE, MOVE_UNDO*), void(*)(CHESS_POSITION*, const MOVE_UNDO*), int(*)(CHESS_POSITION*, PLAYER_COLOR)); // return the score of the best move of the computer
 
 
 
 
 #endif
-#pragma once
@@ -3,6 +3,20 @@
 
 #define CLI_ARG_STRING_INTERFACE_MODE_CONSOLE   "console"
 #define CLI_ARG_STRING_INTERFACE_MODE_GUI       "gui"
+#define CLI_ARG_STRING_HASH_SIZE                "-hash"     /* followed by the transposition table size in megabytes */
+#define CLI_ARG_STRING_MOVE_TIME                "-movetime" /* followed by the "best" difficulty time budget in milliseconds */
+#define CLI_ARG_STRING_MOVE_NODES               "-nodes"    /* followed by the "best" difficulty node budget */
+#define CLI_ARG_STRING_THREADS                  "-threads"  /* followed by the number of search threads */
+#define CLI_ARG_STRING_DISABLE                  "-disable"  /* followed by a search feature to switch off, for engine matches */
+
+#define CLI_FEATURE_STRING_PVS                  "pvs"
+#define CLI_FEATURE_STRING_ASPIRATION           "aspiration"
+#define CLI_FEATURE_STRING_NULL_MOVE            "nullmove"
+#define CLI_FEATURE_STRING_LMR                  "lmr"
+#define CLI_FEATURE_STRING_FUTILITY             "futility"
+#define CLI_FEATURE_STRING_RAZORING             "razoring"
+#define CLI_FEATURE_STRING_CHECK_EXTENSION      "checkext"
+#define CLI_FEATURE_STRING_SINGLE_REPLY         "singlereply"
 
 #define BOARD_INTERFACE_FIRST_COLUMN            'a'
 #define BOARD_INTERFACE_FIRST_ROW               '1'
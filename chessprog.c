@@ -5,11 +5,37 @@
 #include "ChessCommonDefs.h"
 #include "InterfaceDefinitions.h"
 #include "ChessFlowController.h"
+#include "ChessLogic.h"
+
+/* the search features the command line can switch off */
+typedef struct
+{
+	const char* name;
+	int feature;
+} CLI_FEATURE;
+
+static const CLI_FEATURE m_cliFeatures[] =
+{
+	{ CLI_FEATURE_STRING_PVS,        SEARCH_FEATURE_PVS },
+	{ CLI_FEATURE_STRING_ASPIRATION, SEARCH_FEATURE_ASPIRATION },
+	{ CLI_FEATURE_STRING_NULL_MOVE,  SEARCH_FEATURE_NULL_MOVE },
+	{ CLI_FEATURE_STRING_LMR,        SEARCH_FEATURE_LMR },
+	{ CLI_FEATURE_STRING_FUTILITY,   SEARCH_FEATURE_FUTILITY },
+	{ CLI_FEATURE_STRING_RAZORING,   SEARCH_FEATURE_RAZORING },
+	{ CLI_FEATURE_STRING_CHECK_EXTENSION, SEARCH_FEATURE_CHECK_EXTENSION },
+	{ CLI_FEATURE_STRING_SINGLE_REPLY, SEARCH_FEATURE_SINGLE_REPLY },
+};
+
+#define CLI_FEATURES_SIZE	(sizeof(m_cliFeatures) / sizeof(m_cliFeatures[0]))
 
 int main(int argc, const char* argv[])
 {
 	const char* interfaceModeString = NULL;
 	INTERFACE_MODE interfaceMode = INTERFACE_MODE_CONSOLE; 
+	int argIndex;
+	unsigned int featureIndex;
+	unsigned int moveTime = 0;
+	unsigned long long moveNodes = 0;
 
 	if (argc > 1)
 	{
@@ -33,6 +59,55 @@ int main(int argc, const char* argv[])
 		interfaceMode = INTERFACE_MODE_DEFAULT;
 	}
 
+	// engine options may follow the interface mode
+	for (argIndex = 1; argIndex < argc - 1; argIndex++)
+	{
+		if (0 == strcmp(argv[argIndex], CLI_ARG_STRING_HASH_SIZE))
+		{
+			argIndex++;
+			if (0 == ChessLogicSetHashSize((unsigned int)atoi(argv[argIndex])))
+			{
+				printf("Invalid hash size, using the default\n");
+			}
+		}
+		else if (0 == strcmp(argv[argIndex], CLI_ARG_STRING_MOVE_TIME))
+		{
+			moveTime = (unsigned int)atoi(argv[++argIndex]);
+		}
+		else if (0 == strcmp(argv[argIndex], CLI_ARG_STRING_MOVE_NODES))
+		{
+			moveNodes = strtoull(argv[++argIndex], NULL, 10);
+		}
+		else if (0 == strcmp(argv[argIndex], CLI_ARG_STRING_THREADS))
+		{
+			argIndex++;
+			if (0 == ChessLogicSetThreads(atoi(argv[argIndex])))
+			{
+				printf("Invalid number of threads, using one\n");
+			}
+		}
+		else if (0 == strcmp(argv[argIndex], CLI_ARG_STRING_DISABLE))
+		{
+			argIndex++;
+			for (featureIndex = 0; featureIndex < CLI_FEATURES_SIZE; featureIndex++)
+			{
+				if (0 == strcmp(argv[argIndex], m_cliFeatures[featureIndex].name))
+				{
+					ChessLogicSetSearchFeature(m_cliFeatures[featureIndex].feature, 0);
+					break;
+				}
+			}
+			if (featureIndex == CLI_FEATURES_SIZE)
+			{
+				printf("Unknown search feature %s\n", argv[argIndex]);
+			}
+		}
+	}
+	if (moveTime != 0 || moveNodes != 0)
+	{
+		ChessLogicSetSearchBudget(moveTime, moveNodes);
+	}
+
 	ChessControllerInit(interfaceMode);
 	ChessControllerRun();
 